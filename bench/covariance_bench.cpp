@@ -0,0 +1,117 @@
+// Per-bar update cost of EwmaCovariance and RollingCovariance over a large
+// universe, on the calling thread and on the engine's worker pool, plus the
+// bare dispatch cost of a pool run vs creating threads for every update.
+//
+//   covariance_bench [symbols] [updates] [threads]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "core/parallel.h"
+#include "core/thread_pool.h"
+#include "metrics/covariance.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<std::vector<double>> makeCrossSections(std::size_t symbols, std::size_t count)
+    {
+        std::mt19937_64 rng(42);
+        std::normal_distribution<double> ret(0.0, 0.01);
+        std::vector<std::vector<double>> out(count, std::vector<double>(symbols));
+        for (auto &row : out)
+        {
+            for (double &r : row)
+            {
+                r = ret(rng);
+            }
+        }
+        return out;
+    }
+
+    double msPer(Clock::duration elapsed, std::size_t count)
+    {
+        return std::chrono::duration<double, std::milli>(elapsed).count() / static_cast<double>(count);
+    }
+
+    // Milliseconds per EWMA update after one warm-up update.
+    double ewmaUpdate(trading::EwmaCovariance &engine, const std::vector<std::vector<double>> &rows)
+    {
+        engine.update(0, rows[0]);
+        const auto start = Clock::now();
+        for (std::size_t t = 1; t < rows.size(); ++t)
+        {
+            engine.update(static_cast<trading::EpochSeconds>(t) * 86400, rows[t]);
+        }
+        return msPer(Clock::now() - start, rows.size() - 1);
+    }
+
+    // Milliseconds per full-window rolling update (replaces the oldest row).
+    double rollingUpdate(trading::RollingCovariance &engine, const std::vector<std::vector<double>> &rows)
+    {
+        std::size_t t = 0;
+        while (!engine.update(rows[t % rows.size()]))
+        {
+            ++t;
+        }
+        const std::size_t updates = rows.size();
+        const auto start = Clock::now();
+        for (std::size_t k = 0; k < updates; ++k)
+        {
+            engine.update(rows[(t + k) % rows.size()]);
+        }
+        return msPer(Clock::now() - start, updates);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const std::size_t symbols = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4000;
+    const std::size_t updates = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 20;
+    const std::size_t threads = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 0;
+    const std::size_t window = 16;
+
+    const auto rows = makeCrossSections(symbols, updates + 1);
+    trading::ThreadPool pool(threads);
+    std::cout << "symbols=" << symbols << " updates=" << updates << " pool threads=" << pool.threadCount() << "\n";
+
+    {
+        trading::EwmaCovariance serial(symbols, 5.0, 1);
+        std::cout << "ewma    update, calling thread: " << ewmaUpdate(serial, rows) << " ms\n";
+    }
+    {
+        trading::EwmaCovariance pooled(symbols, 5.0, pool);
+        std::cout << "ewma    update, worker pool:    " << ewmaUpdate(pooled, rows) << " ms\n";
+    }
+    {
+        trading::RollingCovariance serial(symbols, window, 1);
+        std::cout << "rolling update, calling thread: " << rollingUpdate(serial, rows) << " ms\n";
+    }
+    {
+        trading::RollingCovariance pooled(symbols, window, pool);
+        std::cout << "rolling update, worker pool:    " << rollingUpdate(pooled, rows) << " ms\n";
+    }
+
+    // What each update pays just to get its row chunks onto other threads.
+    const std::size_t chunks = (symbols + 31) / 32;
+    const std::size_t dispatches = 200;
+    auto start = Clock::now();
+    for (std::size_t k = 0; k < dispatches; ++k)
+    {
+        trading::parallelFor(chunks, pool.threadCount() + 1, [](std::size_t) {});
+    }
+    const double spawn = msPer(Clock::now() - start, dispatches);
+    start = Clock::now();
+    for (std::size_t k = 0; k < dispatches; ++k)
+    {
+        pool.parallelFor(chunks, [](std::size_t) {});
+    }
+    const double reuse = msPer(Clock::now() - start, dispatches);
+    std::cout << "empty dispatch of " << chunks << " chunks: new threads " << spawn * 1000.0
+              << " us, worker pool " << reuse * 1000.0 << " us\n";
+    return 0;
+}
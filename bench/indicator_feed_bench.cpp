@@ -0,0 +1,103 @@
+// Publish-to-read latency of the shared-memory indicator feed between two
+// processes. The parent publishes, a forked child polls the slot and records
+// (read time - publish time) for every update it sees.
+//
+//   indicator_feed_bench [messages] [gap_ns]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "data/indicator_feed.h"
+
+namespace
+{
+    std::uint64_t steadyNs()
+    {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+    }
+
+    int runReader(const std::string &name, std::size_t messages)
+    {
+        trading::IndicatorReader reader(name);
+        std::vector<std::uint64_t> latencies;
+        latencies.reserve(messages);
+
+        std::uint64_t last = 0;
+        while (last < messages)
+        {
+            if (reader.updates(0) == last)
+            {
+                continue;
+            }
+            const auto values = reader.read(0);
+            const std::uint64_t now = steadyNs();
+            if (values && values->updates != last)
+            {
+                last = values->updates;
+                latencies.push_back(now - values->publishedNs);
+            }
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        const auto pct = [&](double p)
+        {
+            return latencies[static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1))];
+        };
+        std::cout << "observed " << latencies.size() << " of " << messages << " updates\n"
+                  << "latency ns  p50 " << pct(0.50) << "  p90 " << pct(0.90) << "  p99 " << pct(0.99)
+                  << "  p99.9 " << pct(0.999) << "  max " << latencies.back() << '\n';
+        return 0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const std::size_t messages = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    const std::uint64_t gapNs = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 2000;
+    const std::string name = "/trading_feed_bench_" + std::to_string(getpid());
+
+    trading::IndicatorPublisher publisher(name, 1);
+    const std::size_t slot = publisher.addSymbol("BENCH");
+
+    const pid_t child = fork();
+    if (child < 0)
+    {
+        std::cerr << "fork failed\n";
+        return 1;
+    }
+    if (child == 0)
+    {
+        // Skip destructors: the publisher (and the region's name) belong to the parent.
+        const int status = runReader(name, messages);
+        std::cout.flush();
+        _exit(status);
+    }
+
+    usleep(100000); // let the reader map the region
+    trading::IndicatorValues values;
+    for (std::size_t k = 1; k <= messages; ++k)
+    {
+        values.timestamp = static_cast<trading::EpochSeconds>(k);
+        values.close = static_cast<double>(k);
+        publisher.publish(slot, values);
+        const std::uint64_t until = steadyNs() + gapNs;
+        while (steadyNs() < until)
+        {
+        }
+    }
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
@@ -0,0 +1,113 @@
+// Float vs double throughput of the mixed-precision metric kernels over a
+// synthetic universe (random-walk closes, one series per symbol).
+//
+//   mixed_precision_bench [symbols] [bars] [repeats]
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "metrics/mixed_precision.h"
+
+namespace
+{
+    struct Universe
+    {
+        std::vector<trading::EpochSeconds> timestamps;
+        std::vector<std::vector<double>> close;
+        std::vector<std::vector<double>> volume;
+    };
+
+    Universe makeUniverse(std::size_t symbols, std::size_t bars)
+    {
+        Universe u;
+        u.timestamps.resize(bars);
+        for (std::size_t i = 0; i < bars; ++i)
+        {
+            u.timestamps[i] = 1704067200 + static_cast<trading::EpochSeconds>(i) * 86400;
+        }
+
+        std::mt19937_64 rng(42);
+        std::normal_distribution<double> step(0.0, 0.01);
+        std::uniform_real_distribution<double> vol(1e4, 1e6);
+        u.close.resize(symbols);
+        u.volume.resize(symbols);
+        for (std::size_t s = 0; s < symbols; ++s)
+        {
+            double price = 100.0;
+            u.close[s].resize(bars);
+            u.volume[s].resize(bars);
+            for (std::size_t i = 0; i < bars; ++i)
+            {
+                price *= std::exp(step(rng));
+                u.close[s][i] = price;
+                u.volume[s][i] = vol(rng);
+            }
+        }
+        return u;
+    }
+
+    template <typename T>
+    std::vector<std::vector<T>> convert(const std::vector<std::vector<double>> &in)
+    {
+        std::vector<std::vector<T>> out(in.size());
+        for (std::size_t s = 0; s < in.size(); ++s)
+        {
+            out[s].assign(in[s].begin(), in[s].end());
+        }
+        return out;
+    }
+
+    // Runs the full kernel set over every symbol; returns seconds per sweep.
+    template <typename T>
+    double sweep(const Universe &u, std::size_t repeats, double &checksum)
+    {
+        const auto close = convert<T>(u.close);
+        const auto volume = convert<T>(u.volume);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t r = 0; r < repeats; ++r)
+        {
+            for (std::size_t s = 0; s < close.size(); ++s)
+            {
+                const auto twma = trading::twma_series(u.timestamps, close[s], 10.0);
+                const auto vwma = trading::vwma_series(close[s], volume[s], 20);
+                const auto equity = trading::equity_curve(close[s], 1.0);
+                checksum += static_cast<double>(twma.back()) + static_cast<double>(vwma.back());
+                checksum += trading::max_drawdown_of(equity);
+                checksum += trading::return_metrics_of(equity).annualized_return;
+            }
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / static_cast<double>(repeats);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const std::size_t symbols = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 500;
+    const std::size_t bars = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 5000;
+    const std::size_t repeats = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 5;
+    if (symbols == 0 || bars < 20 || repeats == 0)
+    {
+        std::cerr << "usage: mixed_precision_bench [symbols>0] [bars>=20] [repeats>0]\n";
+        return 1;
+    }
+
+    const auto universe = makeUniverse(symbols, bars);
+    const double values = static_cast<double>(symbols * bars);
+
+    double checksum64 = 0.0;
+    double checksum32 = 0.0;
+    const double t64 = sweep<double>(universe, repeats, checksum64);
+    const double t32 = sweep<float>(universe, repeats, checksum32);
+
+    std::cout << symbols << " symbols x " << bars << " bars, " << repeats << " repeats\n";
+    std::cout << "double: " << t64 * 1e3 << " ms/sweep, " << values / t64 / 1e6 << " Mbars/s\n";
+    std::cout << "float:  " << t32 * 1e3 << " ms/sweep, " << values / t32 / 1e6 << " Mbars/s\n";
+    std::cout << "speedup " << t64 / t32 << "x, checksum delta " << std::fabs(checksum64 - checksum32) << '\n';
+    return 0;
+}
@@ -0,0 +1,546 @@
+#include "backtest/run_journal.h"
+
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include "backtest/strategy.h"
+#include "core/instrumentation.h"
+#include "data/csv_loader.h"
+#include "metrics/calculate_equity_curve.h"
+#include "metrics/drawdown.h"
+#include "metrics/moving_average.h"
+
+namespace trading
+{
+    namespace
+    {
+        constexpr char kJournalMagic[4] = {'T', 'J', 'R', 'N'};
+
+        enum class JournalRecord : std::uint8_t
+        {
+            Spec = 1,
+            Input = 2,
+            Stage = 3,
+            Output = 4
+        };
+
+        void putU32(std::vector<std::uint8_t> &out, std::uint32_t v)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+            }
+        }
+
+        void putU64(std::vector<std::uint8_t> &out, std::uint64_t v)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+            }
+        }
+
+        void putF64(std::vector<std::uint8_t> &out, double v)
+        {
+            putU64(out, std::bit_cast<std::uint64_t>(v));
+        }
+
+        void putString(std::vector<std::uint8_t> &out, const std::string &s)
+        {
+            putU32(out, static_cast<std::uint32_t>(s.size()));
+            out.insert(out.end(), s.begin(), s.end());
+        }
+
+        // Bounds-checked little-endian reads over one record payload.
+        class Cursor
+        {
+        public:
+            Cursor(const std::uint8_t *data, std::size_t size) : data_(data), size_(size) {}
+
+            std::uint32_t u32()
+            {
+                std::uint32_t v = 0;
+                const std::uint8_t *p = take(4);
+                for (int i = 0; i < 4; ++i)
+                {
+                    v |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+                }
+                return v;
+            }
+
+            std::uint64_t u64()
+            {
+                std::uint64_t v = 0;
+                const std::uint8_t *p = take(8);
+                for (int i = 0; i < 8; ++i)
+                {
+                    v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+                }
+                return v;
+            }
+
+            double f64() { return std::bit_cast<double>(u64()); }
+
+            std::string string()
+            {
+                const std::uint32_t n = u32();
+                const std::uint8_t *p = take(n);
+                return std::string(reinterpret_cast<const char *>(p), n);
+            }
+
+        private:
+            const std::uint8_t *take(std::size_t n)
+            {
+                if (n > size_ - pos_)
+                {
+                    throw std::runtime_error("journal record payload is truncated");
+                }
+                const std::uint8_t *p = data_ + pos_;
+                pos_ += n;
+                return p;
+            }
+
+            const std::uint8_t *data_;
+            std::size_t size_;
+            std::size_t pos_ = 0;
+        };
+
+        std::uint64_t elapsedNs(std::chrono::steady_clock::time_point start)
+        {
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        bool sameValue(double recorded, double replayed, double tolerance)
+        {
+            if (std::isnan(recorded) || std::isnan(replayed))
+            {
+                return std::isnan(recorded) && std::isnan(replayed);
+            }
+            return std::fabs(recorded - replayed) <= tolerance * std::max(1.0, std::fabs(recorded));
+        }
+    } // namespace
+
+    JournalWriter::JournalWriter(const std::filesystem::path &path)
+        : path_(path), out_(path, std::ios::binary | std::ios::trunc)
+    {
+        if (!out_.is_open())
+        {
+            throw std::runtime_error("Failed to open journal file: " + path.string());
+        }
+        out_.write(kJournalMagic, sizeof(kJournalMagic));
+        std::vector<std::uint8_t> version;
+        putU32(version, kJournalVersion);
+        out_.write(reinterpret_cast<const char *>(version.data()), static_cast<std::streamsize>(version.size()));
+        out_.flush();
+        if (!out_)
+        {
+            throw std::runtime_error("Failed to write journal file: " + path.string());
+        }
+        thread_ = std::thread([this] { drain(); });
+    }
+
+    JournalWriter::~JournalWriter()
+    {
+        try
+        {
+            close();
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
+
+    void JournalWriter::append(std::uint8_t type, const std::vector<std::uint8_t> &payload)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closing_)
+        {
+            throw std::logic_error("JournalWriter is closed");
+        }
+        pending_.push_back(type);
+        putU32(pending_, static_cast<std::uint32_t>(payload.size()));
+        pending_.insert(pending_.end(), payload.begin(), payload.end());
+        wake_.notify_one();
+    }
+
+    void JournalWriter::drain()
+    {
+        std::vector<std::uint8_t> writing;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this] { return !pending_.empty() || closing_; });
+                if (pending_.empty())
+                {
+                    return; // closing and fully drained
+                }
+                writing.swap(pending_);
+            }
+
+            out_.write(reinterpret_cast<const char *>(writing.data()), static_cast<std::streamsize>(writing.size()));
+            out_.flush();
+            writing.clear();
+            if (!out_)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                failed_ = true;
+            }
+        }
+    }
+
+    void JournalWriter::close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closing_ = true;
+        }
+        wake_.notify_one();
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+        if (out_.is_open())
+        {
+            out_.close();
+        }
+        if (failed_)
+        {
+            throw std::runtime_error("Failed to write journal file: " + path_.string());
+        }
+    }
+
+    void JournalWriter::writeSpec(const RunSpec &spec)
+    {
+        std::vector<std::uint8_t> payload;
+        putString(payload, spec.csvPath.string());
+        putF64(payload, spec.twmaTimeConstantDays);
+        putU64(payload, spec.vwmaWindow);
+        putU32(payload, static_cast<std::uint32_t>(spec.periodsPerYear));
+        putF64(payload, spec.startingEquity);
+        append(static_cast<std::uint8_t>(JournalRecord::Spec), payload);
+    }
+
+    void JournalWriter::writeInput(std::uint64_t fingerprint, std::size_t bars)
+    {
+        std::vector<std::uint8_t> payload;
+        putU64(payload, fingerprint);
+        putU64(payload, bars);
+        append(static_cast<std::uint8_t>(JournalRecord::Input), payload);
+    }
+
+    void JournalWriter::writeStage(const std::string &name, std::uint64_t durationNs)
+    {
+        std::vector<std::uint8_t> payload;
+        putString(payload, name);
+        putU64(payload, durationNs);
+        append(static_cast<std::uint8_t>(JournalRecord::Stage), payload);
+    }
+
+    void JournalWriter::writeOutput(const JournalOutput &output)
+    {
+        std::vector<std::uint8_t> payload;
+        putString(payload, output.name);
+        putF64(payload, output.returns.cumulative_return);
+        putF64(payload, output.returns.avg_period_return);
+        putF64(payload, output.returns.annualized_return);
+        putF64(payload, output.maxDrawdown);
+        append(static_cast<std::uint8_t>(JournalRecord::Output), payload);
+    }
+
+    RunJournal readJournal(const std::filesystem::path &path)
+    {
+        TRADING_TRACE_SCOPE("readJournal");
+
+        if (!std::filesystem::exists(path))
+        {
+            throw std::runtime_error("Journal file not found: " + path.string());
+        }
+        std::ifstream in(path, std::ios::binary);
+        std::vector<std::uint8_t> buffer(std::filesystem::file_size(path));
+        in.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        if (!in)
+        {
+            throw std::runtime_error("Failed to read journal file: " + path.string());
+        }
+
+        if (buffer.size() < 8 || std::memcmp(buffer.data(), kJournalMagic, sizeof(kJournalMagic)) != 0)
+        {
+            throw std::runtime_error("Not a journal file: " + path.string());
+        }
+        Cursor header(buffer.data() + 4, 4);
+        const std::uint32_t version = header.u32();
+        if (version != kJournalVersion)
+        {
+            throw std::runtime_error("Unsupported journal version " + std::to_string(version));
+        }
+
+        RunJournal journal;
+        std::size_t pos = 8;
+        while (pos < buffer.size())
+        {
+            if (buffer.size() - pos < 5)
+            {
+                journal.truncated = true;
+                break;
+            }
+            const auto type = static_cast<JournalRecord>(buffer[pos]);
+            Cursor length(buffer.data() + pos + 1, 4);
+            const std::size_t size = length.u32();
+            pos += 5;
+            if (size > buffer.size() - pos)
+            {
+                journal.truncated = true;
+                break;
+            }
+
+            Cursor payload(buffer.data() + pos, size);
+            switch (type)
+            {
+            case JournalRecord::Spec:
+                journal.spec.csvPath = payload.string();
+                journal.spec.twmaTimeConstantDays = payload.f64();
+                journal.spec.vwmaWindow = static_cast<std::size_t>(payload.u64());
+                journal.spec.periodsPerYear = static_cast<int>(payload.u32());
+                journal.spec.startingEquity = payload.f64();
+                break;
+            case JournalRecord::Input:
+                journal.inputFingerprint = payload.u64();
+                journal.inputBars = static_cast<std::size_t>(payload.u64());
+                break;
+            case JournalRecord::Stage:
+            {
+                JournalStage stage;
+                stage.name = payload.string();
+                stage.durationNs = payload.u64();
+                journal.stages.push_back(std::move(stage));
+                break;
+            }
+            case JournalRecord::Output:
+            {
+                JournalOutput output;
+                output.name = payload.string();
+                output.returns.cumulative_return = payload.f64();
+                output.returns.avg_period_return = payload.f64();
+                output.returns.annualized_return = payload.f64();
+                output.maxDrawdown = payload.f64();
+                journal.outputs.push_back(std::move(output));
+                break;
+            }
+            default:
+                break; // newer record type
+            }
+            pos += size;
+        }
+        return journal;
+    }
+
+    std::uint64_t fingerprintBars(const std::vector<Bar> &bars)
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ULL;
+        const auto mix = [&hash](const void *data, std::size_t n)
+        {
+            const auto *p = static_cast<const unsigned char *>(data);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                hash ^= p[i];
+                hash *= 0x100000001b3ULL;
+            }
+        };
+        const auto mixString = [&](const std::string &s)
+        {
+            mix(s.data(), s.size());
+            mix("", 1); // separator, so "AB"+"C" != "A"+"BC"
+        };
+
+        for (const Bar &bar : bars)
+        {
+            mixString(bar.symbol);
+            mixString(bar.period);
+            mixString(bar.date);
+            mixString(bar.time);
+            const double values[] = {bar.open, bar.high, bar.low, bar.close, bar.volume};
+            mix(values, sizeof(values));
+            mix(&bar.openInterest, sizeof(bar.openInterest));
+        }
+        return hash;
+    }
+
+    RunJournal executeRun(const RunSpec &spec, JournalWriter *journal)
+    {
+        TRADING_TRACE_SCOPE("executeRun");
+
+        RunJournal run;
+        run.spec = spec;
+        if (journal)
+        {
+            journal->writeSpec(spec);
+        }
+
+        const auto stage = [&](const char *name, auto &&body)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            body();
+            const std::uint64_t ns = elapsedNs(start);
+            run.stages.push_back(JournalStage{name, ns});
+            if (journal)
+            {
+                journal->writeStage(name, ns);
+            }
+        };
+
+        std::vector<Bar> bars;
+        stage("load", [&]
+        {
+            bars = loadBarsFromCsv(spec.csvPath);
+        });
+
+        stage("fingerprint", [&]
+        {
+            run.inputFingerprint = fingerprintBars(bars);
+            run.inputBars = bars.size();
+        });
+        if (journal)
+        {
+            journal->writeInput(run.inputFingerprint, run.inputBars);
+        }
+
+        std::vector<double> twma;
+        std::vector<double> vwma;
+        stage("indicators", [&]
+        {
+            TimeWeightedMovingAverage indicator(spec.twmaTimeConstantDays);
+            twma.reserve(bars.size());
+            for (const Bar &bar : bars)
+            {
+                twma.push_back(indicator.update(bar));
+            }
+            vwma = VolumeWeightedMovingAverage::compute(bars, spec.vwmaWindow);
+        });
+
+        std::vector<Position> positions;
+        stage("signals", [&]
+        {
+            positions = crossoverPositions(twma, vwma);
+        });
+
+        std::vector<double> holdEquity;
+        std::vector<double> strategyCurve;
+        stage("equity", [&]
+        {
+            holdEquity = calculate_equity_curve_from_bars(bars, spec.startingEquity);
+            strategyCurve = strategyEquityFromBars(bars, positions, spec.startingEquity, InputCheck::Unchecked);
+        });
+
+        stage("metrics", [&]
+        {
+            const ReturnCalculator calc(spec.periodsPerYear);
+            run.outputs.push_back(JournalOutput{"buy_and_hold", calc.from_equity(holdEquity), max_drawdown(holdEquity)});
+            run.outputs.push_back(JournalOutput{"strategy", calc.from_equity(strategyCurve), max_drawdown(strategyCurve)});
+        });
+
+        if (journal)
+        {
+            for (const JournalOutput &output : run.outputs)
+            {
+                journal->writeOutput(output);
+            }
+        }
+        return run;
+    }
+
+    double StageTimingDiff::ratio() const noexcept
+    {
+        return (recordedNs > 0) ? static_cast<double>(replayedNs) / static_cast<double>(recordedNs) : 0.0;
+    }
+
+    std::string JournalDiff::summary() const
+    {
+        std::ostringstream out;
+        out << (outputsMatch() ? "outputs match" : "OUTPUTS DIFFER") << '\n';
+        if (!inputMatches)
+        {
+            out << "  input fingerprint differs\n";
+        }
+        for (const std::string &line : outputMismatches)
+        {
+            out << "  " << line << '\n';
+        }
+        out << std::fixed << std::setprecision(3);
+        for (const StageTimingDiff &stage : stages)
+        {
+            out << "  " << std::left << std::setw(12) << stage.name << std::right
+                << std::setw(12) << static_cast<double>(stage.recordedNs) / 1e6 << " ms -> "
+                << std::setw(12) << static_cast<double>(stage.replayedNs) / 1e6 << " ms  x"
+                << stage.ratio() << '\n';
+        }
+        return out.str();
+    }
+
+    JournalDiff replayJournal(const RunJournal &journal, double tolerance)
+    {
+        TRADING_TRACE_SCOPE("replayJournal");
+
+        JournalDiff diff;
+        diff.replayed = executeRun(journal.spec);
+        diff.inputMatches = diff.replayed.inputFingerprint == journal.inputFingerprint &&
+                            diff.replayed.inputBars == journal.inputBars;
+
+        for (const JournalOutput &recorded : journal.outputs)
+        {
+            const JournalOutput *replayed = nullptr;
+            for (const JournalOutput &candidate : diff.replayed.outputs)
+            {
+                if (candidate.name == recorded.name)
+                {
+                    replayed = &candidate;
+                }
+            }
+            if (!replayed)
+            {
+                diff.outputMismatches.push_back(recorded.name + ": missing from replay");
+                continue;
+            }
+
+            const auto compare = [&](const char *field, double a, double b)
+            {
+                if (!sameValue(a, b, tolerance))
+                {
+                    std::ostringstream line;
+                    line << std::setprecision(17) << recorded.name << '.' << field << ": " << a << " -> " << b;
+                    diff.outputMismatches.push_back(line.str());
+                }
+            };
+            compare("cumulative_return", recorded.returns.cumulative_return, replayed->returns.cumulative_return);
+            compare("avg_period_return", recorded.returns.avg_period_return, replayed->returns.avg_period_return);
+            compare("annualized_return", recorded.returns.annualized_return, replayed->returns.annualized_return);
+            compare("max_drawdown", recorded.maxDrawdown, replayed->maxDrawdown);
+        }
+
+        for (const JournalStage &recorded : journal.stages)
+        {
+            StageTimingDiff stage{recorded.name, recorded.durationNs, 0};
+            for (const JournalStage &replayed : diff.replayed.stages)
+            {
+                if (replayed.name == recorded.name)
+                {
+                    stage.replayedNs = replayed.durationNs;
+                }
+            }
+            diff.stages.push_back(stage);
+        }
+        return diff;
+    }
+
+    JournalDiff replayJournal(const std::filesystem::path &path, double tolerance)
+    {
+        return replayJournal(readJournal(path), tolerance);
+    }
+
+} // namespace trading
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/bar.h"
+#include "metrics/return_metrics.h"
+
+namespace trading
+{
+
+    // Everything needed to re-execute a run deterministically.
+    struct RunSpec
+    {
+        std::filesystem::path csvPath;
+        double twmaTimeConstantDays = 5.0;
+        std::size_t vwmaWindow = 20;
+        int periodsPerYear = 245;
+        double startingEquity = 1.0;
+    };
+
+    // Wall time of one pipeline stage.
+    struct JournalStage
+    {
+        std::string name;
+        std::uint64_t durationNs = 0;
+    };
+
+    // Final metrics of one equity curve of the run.
+    struct JournalOutput
+    {
+        std::string name;
+        ReturnMetrics returns;
+        double maxDrawdown = 0.0;
+    };
+
+    // A decoded journal (or the result of executing a run).
+    struct RunJournal
+    {
+        RunSpec spec;
+        std::uint64_t inputFingerprint = 0; // fingerprintBars() of the loaded bars
+        std::size_t inputBars = 0;
+        std::vector<JournalStage> stages;
+        std::vector<JournalOutput> outputs;
+        bool truncated = false; // the file ended inside a record (e.g. the writer crashed)
+    };
+
+    // Journal file layout (little-endian):
+    //   header:  magic "TJRN", u32 version
+    //   record:  u8 type, u32 payload length, payload
+    // Records are appended as the run progresses; readers skip unknown types.
+    constexpr std::uint32_t kJournalVersion = 1;
+
+    // Appends journal records from any thread. Callers only encode a few bytes
+    // into a buffer under a mutex; a background thread does all file I/O, so
+    // journaling never waits on the disk.
+    class JournalWriter
+    {
+    public:
+        // Create/truncate the file and write the header. Throws std::runtime_error.
+        explicit JournalWriter(const std::filesystem::path &path);
+        ~JournalWriter(); // close(), swallowing I/O errors
+
+        JournalWriter(const JournalWriter &) = delete;
+        JournalWriter &operator=(const JournalWriter &) = delete;
+
+        void writeSpec(const RunSpec &spec);
+        void writeInput(std::uint64_t fingerprint, std::size_t bars);
+        void writeStage(const std::string &name, std::uint64_t durationNs);
+        void writeOutput(const JournalOutput &output);
+
+        // Drain pending records, flush and stop the background thread.
+        // Throws std::runtime_error if any write failed.
+        void close();
+
+    private:
+        void append(std::uint8_t type, const std::vector<std::uint8_t> &payload);
+        void drain();
+
+        std::filesystem::path path_;
+        std::ofstream out_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::vector<std::uint8_t> pending_;
+        bool closing_ = false;
+        bool failed_ = false;
+        std::thread thread_;
+    };
+
+    // Read a journal file. Throws std::runtime_error on a bad magic or version.
+    RunJournal readJournal(const std::filesystem::path &path);
+
+    // 64-bit FNV-1a hash over every field of every bar.
+    std::uint64_t fingerprintBars(const std::vector<Bar> &bars);
+
+    // Execute the run: load -> fingerprint -> indicators (TWMA, VWMA) ->
+    // signals (long/flat crossover) -> equity (buy-and-hold and strategy) ->
+    // metrics. Outputs are "buy_and_hold" and "strategy". Records to journal
+    // when one is given.
+    RunJournal executeRun(const RunSpec &spec, JournalWriter *journal = nullptr);
+
+    struct StageTimingDiff
+    {
+        std::string name;
+        std::uint64_t recordedNs = 0;
+        std::uint64_t replayedNs = 0;
+
+        // replayed / recorded; > 1 means the replay was slower.
+        double ratio() const noexcept;
+    };
+
+    struct JournalDiff
+    {
+        bool inputMatches = true;
+        std::vector<std::string> outputMismatches; // one line per differing value
+        std::vector<StageTimingDiff> stages;
+        RunJournal replayed;
+
+        bool outputsMatch() const noexcept { return inputMatches && outputMismatches.empty(); }
+        std::string summary() const;
+    };
+
+    // Re-execute a journaled run and compare it with the journal. Outputs
+    // differ when |a - b| > tolerance * max(1, |a|) (0 = bit-exact up to NaN).
+    JournalDiff replayJournal(const RunJournal &journal, double tolerance = 0.0);
+    JournalDiff replayJournal(const std::filesystem::path &path, double tolerance = 0.0);
+
+} // namespace trading
@@ -0,0 +1,123 @@
+#include "backtest/strategy.h"
+
+#include <stdexcept>
+
+#include "core/instrumentation.h"
+
+namespace trading
+{
+
+    std::vector<Position> crossoverPositions(const std::vector<double> &fast,
+                                             const std::vector<double> &slow,
+                                             Position aboveValue,
+                                             Position belowValue)
+    {
+        TRADING_TRACE_SCOPE("crossoverPositions");
+
+        if (fast.size() != slow.size())
+        {
+            throw std::invalid_argument("fast and slow series must have the same length");
+        }
+
+        std::vector<Position> positions(fast.size());
+        for (std::size_t i = 0; i < fast.size(); ++i)
+        {
+            // Both comparisons are false when either side is NaN.
+            const int above = fast[i] > slow[i];
+            const int below = fast[i] < slow[i];
+            positions[i] = static_cast<Position>(above * aboveValue + below * belowValue);
+        }
+        return positions;
+    }
+
+    std::vector<Position> thresholdPositions(const std::vector<double> &signal,
+                                             double upper,
+                                             double lower,
+                                             Position aboveValue,
+                                             Position belowValue)
+    {
+        TRADING_TRACE_SCOPE("thresholdPositions");
+
+        if (!(lower <= upper))
+        {
+            throw std::invalid_argument("threshold lower must be <= upper");
+        }
+
+        std::vector<Position> positions(signal.size());
+        for (std::size_t i = 0; i < signal.size(); ++i)
+        {
+            const int above = signal[i] > upper;
+            const int below = signal[i] < lower;
+            positions[i] = static_cast<Position>(above * aboveValue + below * belowValue);
+        }
+        return positions;
+    }
+
+    void strategyEquity(const double *closes,
+                        const Position *positions,
+                        std::size_t count,
+                        double startingEquity,
+                        double *out)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        out[0] = startingEquity;
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            const double r = closes[i] / closes[i - 1] - 1.0;
+            out[i] = out[i - 1] * (1.0 + positions[i - 1] * r);
+        }
+    }
+
+    std::vector<double> strategyEquity(const std::vector<double> &closes,
+                                       const std::vector<Position> &positions,
+                                       double startingEquity,
+                                       InputCheck check)
+    {
+        TRADING_TRACE_SCOPE("strategyEquity");
+
+        if (startingEquity <= 0.0)
+        {
+            throw std::invalid_argument("starting_equity must be > 0");
+        }
+        if (closes.empty())
+        {
+            throw std::invalid_argument("closes must not be empty");
+        }
+        if (closes.size() != positions.size())
+        {
+            throw std::invalid_argument("closes and positions must have the same length");
+        }
+        if (check == InputCheck::Checked)
+        {
+            for (double close : closes)
+            {
+                if (close <= 0.0)
+                {
+                    throw std::invalid_argument("bar close must be > 0 to compute returns");
+                }
+            }
+        }
+
+        std::vector<double> equity(closes.size());
+        strategyEquity(closes.data(), positions.data(), closes.size(), startingEquity, equity.data());
+        return equity;
+    }
+
+    std::vector<double> strategyEquityFromBars(const std::vector<Bar> &bars,
+                                               const std::vector<Position> &positions,
+                                               double startingEquity,
+                                               InputCheck check)
+    {
+        std::vector<double> closes;
+        closes.reserve(bars.size());
+        for (const Bar &bar : bars)
+        {
+            closes.push_back(bar.close);
+        }
+        return strategyEquity(closes, positions, startingEquity, check);
+    }
+
+} // namespace trading
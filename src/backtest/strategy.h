@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/bar.h"
+#include "core/input_check.h"
+
+namespace trading
+{
+
+    // Target exposure held over the next bar: -1 short, 0 flat, +1 long.
+    using Position = std::int8_t;
+
+    // Position series from two indicator series (e.g. TWMA vs VWMA):
+    // aboveValue where fast > slow, belowValue where fast < slow, flat where they
+    // are equal or either side is NaN (indicator warm-up).
+    // Long-only crossover: (1, 0); long/short: (1, -1).
+    std::vector<Position> crossoverPositions(const std::vector<double> &fast,
+                                             const std::vector<double> &slow,
+                                             Position aboveValue = 1,
+                                             Position belowValue = 0);
+
+    // Position series from a single signal: aboveValue where signal > upper,
+    // belowValue where signal < lower, flat in between and on NaN.
+    std::vector<Position> thresholdPositions(const std::vector<double> &signal,
+                                             double upper,
+                                             double lower,
+                                             Position aboveValue = 1,
+                                             Position belowValue = -1);
+
+    // Equity of holding positions[i] over the close-to-close return i -> i+1:
+    // out[0] = startingEquity, out[i] = out[i-1] * (1 + positions[i-1] * r_i).
+    // Writes count values; positions[count - 1] is not used. The loop has no
+    // data-dependent branches. Short positions through a return above 100%
+    // make the equity non-positive, which the Checked metric kernels reject.
+    void strategyEquity(const double *closes,
+                        const Position *positions,
+                        std::size_t count,
+                        double startingEquity,
+                        double *out);
+
+    // Same over whole series; closes.size() == positions.size() > 0.
+    // InputCheck::Unchecked skips the per-bar close > 0 check.
+    std::vector<double> strategyEquity(const std::vector<double> &closes,
+                                       const std::vector<Position> &positions,
+                                       double startingEquity = 1.0,
+                                       InputCheck check = InputCheck::Checked);
+
+    std::vector<double> strategyEquityFromBars(const std::vector<Bar> &bars,
+                                               const std::vector<Position> &positions,
+                                               double startingEquity = 1.0,
+                                               InputCheck check = InputCheck::Checked);
+
+} // namespace trading
@@ -0,0 +1,107 @@
+#include "backtest/symbol_metrics.h"
+
+#include <stdexcept>
+
+#include "core/instrumentation.h"
+#include "metrics/drawdown.h"
+#include "metrics/mixed_precision.h"
+
+namespace trading
+{
+
+    SymbolPartition::SymbolPartition(const BarColumns &columns, TaskScheduler &scheduler)
+    {
+        TRADING_TRACE_SCOPE("SymbolPartition");
+
+        const std::vector<SymbolRows> groups = groupBySymbol(columns);
+        symbols_.resize(groups.size());
+        for (std::size_t g = 0; g < groups.size(); ++g)
+        {
+            symbols_[g].symbol = groups[g].symbol;
+            symbols_[g].worker = scheduler.homeWorker(groups[g].symbol);
+        }
+
+        // Each home worker allocates and fills its own symbols' columns. No
+        // stealing here: a thief on another node would first-touch them there.
+        scheduler.run(groups.size(), homeWorkers(), [&](std::size_t g, std::size_t)
+        {
+            symbols_[g].columns = selectRows(columns, groups[g].rows);
+        }, Stealing::Disabled);
+    }
+
+    std::vector<std::size_t> SymbolPartition::homeWorkers() const
+    {
+        std::vector<std::size_t> home(symbols_.size());
+        for (std::size_t g = 0; g < symbols_.size(); ++g)
+        {
+            home[g] = symbols_[g].worker;
+        }
+        return home;
+    }
+
+    SymbolMetricsRun runSymbolMetrics(const SymbolPartition &partition,
+                                      TaskScheduler &scheduler,
+                                      const ReturnCalculator &calc,
+                                      double startingEquity)
+    {
+        TRADING_TRACE_SCOPE("runSymbolMetrics");
+
+        // A bad start applies to every symbol, so it is the caller's error.
+        if (!(startingEquity > 0.0))
+        {
+            throw std::invalid_argument("starting_equity must be > 0");
+        }
+
+        const std::vector<PlacedSymbol> &placed = partition.symbols();
+        SymbolMetricsRun run;
+        run.symbols.resize(placed.size());
+        for (std::size_t g = 0; g < placed.size(); ++g)
+        {
+            run.symbols[g].symbol = symbolTable().name(placed[g].symbol);
+        }
+
+        run.stats = scheduler.run(placed.size(), partition.homeWorkers(), [&](std::size_t g, std::size_t worker)
+        {
+            const std::vector<double> &close = placed[g].columns.close;
+            SymbolMetrics &out = run.symbols[g];
+            out.bars = close.size();
+            out.node = scheduler.workerNode(worker);
+            if (close.size() < 2)
+            {
+                out.error = "need at least 2 bars to compute returns";
+                return;
+            }
+            for (double c : close)
+            {
+                if (!(c > 0.0))
+                {
+                    out.error = "bar close must be > 0 to compute returns";
+                    return;
+                }
+            }
+
+            try
+            {
+                const std::vector<double> equity = equity_curve(close, startingEquity);
+                out.returns = calc.from_equity(equity, InputCheck::Unchecked);
+                out.maxDrawdown = max_drawdown(equity, InputCheck::Unchecked);
+            }
+            catch (const std::invalid_argument &e)
+            {
+                out.error = e.what();
+            }
+        });
+
+        return run;
+    }
+
+    SymbolMetricsRun runSymbolMetrics(const std::vector<Bar> &bars,
+                                      TaskScheduler &scheduler,
+                                      const ReturnCalculator &calc,
+                                      double startingEquity)
+    {
+        const SymbolPartition partition(toColumns(bars), scheduler);
+        return runSymbolMetrics(partition, scheduler, calc, startingEquity);
+    }
+
+} // namespace trading
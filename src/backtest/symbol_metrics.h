@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "core/bar.h"
+#include "core/bar_columns.h"
+#include "core/symbol_table.h"
+#include "core/task_scheduler.h"
+#include "metrics/return_metrics.h"
+
+namespace trading
+{
+
+    // Buy-and-hold metrics of one symbol.
+    struct SymbolMetrics
+    {
+        std::string symbol;
+        std::size_t bars = 0;
+        ReturnMetrics returns;
+        double maxDrawdown = 0.0;
+        int node = 0;      // NUMA node that computed it
+        std::string error; // why the symbol was skipped; empty if the metrics are valid
+
+        bool ok() const noexcept { return error.empty(); }
+    };
+
+    struct SymbolMetricsRun
+    {
+        std::vector<SymbolMetrics> symbols; // in order of first appearance
+        SchedulerStats stats;
+    };
+
+    // One symbol's columns, owned by its home worker.
+    struct PlacedSymbol
+    {
+        SymbolId symbol = 0;
+        std::size_t worker = 0; // TaskScheduler::homeWorker(symbol)
+        BarColumns columns;
+    };
+
+    // A multi-symbol series split into per-symbol columns, each placed on one
+    // NUMA node. Every symbol is pinned to scheduler.homeWorker(symbol id) and
+    // its columns are copied by that worker, so first-touch puts them on that
+    // worker's node. Build it once and reuse it across runs with the same
+    // scheduler: later runs queue each symbol on the same worker, where its
+    // data already lives.
+    class SymbolPartition
+    {
+    public:
+        SymbolPartition(const BarColumns &columns, TaskScheduler &scheduler);
+
+        // In order of first appearance.
+        const std::vector<PlacedSymbol> &symbols() const noexcept { return symbols_; }
+
+        // Home worker of every symbol, for TaskScheduler::run.
+        std::vector<std::size_t> homeWorkers() const;
+
+    private:
+        std::vector<PlacedSymbol> symbols_;
+    };
+
+    // Run equity curve -> ReturnCalculator -> max_drawdown for every symbol of
+    // the partition, one scheduler task per symbol on its home worker. A symbol
+    // whose bars cannot be measured (fewer than 2 bars, a non-positive close)
+    // is skipped with its error recorded; the other symbols still run.
+    SymbolMetricsRun runSymbolMetrics(const SymbolPartition &partition,
+                                      TaskScheduler &scheduler,
+                                      const ReturnCalculator &calc = ReturnCalculator(),
+                                      double startingEquity = 1.0);
+
+    // One-off convenience: partitions bars (each symbol's bars in time order)
+    // and runs the metrics on them. Keep a SymbolPartition for repeated runs.
+    SymbolMetricsRun runSymbolMetrics(const std::vector<Bar> &bars,
+                                      TaskScheduler &scheduler,
+                                      const ReturnCalculator &calc = ReturnCalculator(),
+                                      double startingEquity = 1.0);
+
+} // namespace trading
@@ -0,0 +1,210 @@
+#include "backtest/walk_forward.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "backtest/strategy.h"
+#include "core/instrumentation.h"
+#include "core/parallel.h"
+#include "metrics/drawdown.h"
+#include "metrics/moving_average.h"
+
+namespace trading
+{
+    namespace
+    {
+        // Equity of holding positions[i] over each return i -> i+1 for bars in [begin, end).
+        std::vector<double> segmentEquity(const std::vector<double> &closes,
+                                          const std::vector<Position> &positions,
+                                          std::size_t begin,
+                                          std::size_t end)
+        {
+            std::vector<double> equity(end - begin);
+            strategyEquity(closes.data() + begin, positions.data() + begin, end - begin, 1.0, equity.data());
+            return equity;
+        }
+    } // namespace
+
+    std::vector<WalkForwardFold> makeWalkForwardFolds(
+        std::size_t barCount,
+        std::size_t trainSize,
+        std::size_t testSize,
+        FoldScheme scheme)
+    {
+        if (trainSize < 2 || testSize == 0)
+        {
+            throw std::invalid_argument("trainSize must be >= 2 and testSize must be > 0");
+        }
+
+        std::vector<WalkForwardFold> folds;
+        for (std::size_t k = 0;; ++k)
+        {
+            WalkForwardFold fold;
+            fold.trainBegin = (scheme == FoldScheme::Rolling) ? k * testSize : 0;
+            fold.trainEnd = trainSize + k * testSize;
+            fold.testBegin = fold.trainEnd;
+            if (fold.testBegin >= barCount)
+            {
+                break;
+            }
+            fold.testEnd = std::min(fold.testBegin + testSize, barCount);
+            folds.push_back(fold);
+        }
+        return folds;
+    }
+
+    std::vector<ParameterSet> makeParameterGrid(const WalkForwardConfig &config)
+    {
+        std::vector<ParameterSet> grid;
+        grid.reserve(config.twmaTimeConstants.size() * config.vwmaWindows.size());
+        for (double tau : config.twmaTimeConstants)
+        {
+            for (std::size_t window : config.vwmaWindows)
+            {
+                grid.push_back(ParameterSet{tau, window});
+            }
+        }
+        return grid;
+    }
+
+    double scoreEquity(const std::vector<double> &equity,
+                       SelectionMetric metric,
+                       const ReturnCalculator &calc,
+                       InputCheck check,
+                       double minDrawdown)
+    {
+        switch (metric)
+        {
+        case SelectionMetric::CumulativeReturn:
+            return calc.from_equity(equity, check).cumulative_return;
+        case SelectionMetric::AnnualizedReturn:
+            return calc.from_equity(equity, check).annualized_return;
+        case SelectionMetric::MaxDrawdown:
+            return -max_drawdown(equity, check);
+        case SelectionMetric::ReturnOverDrawdown:
+        {
+            if (!(minDrawdown > 0.0))
+            {
+                throw std::invalid_argument("minDrawdown must be > 0");
+            }
+            const double dd = std::max(max_drawdown(equity, check), minDrawdown);
+            return calc.from_equity(equity, check).annualized_return / dd;
+        }
+        }
+        return 0.0;
+    }
+
+    WalkForwardResult runWalkForward(const std::vector<Bar> &bars, const WalkForwardConfig &config)
+    {
+        TRADING_TRACE_SCOPE("runWalkForward");
+
+        const std::vector<ParameterSet> grid = makeParameterGrid(config);
+        if (grid.empty())
+        {
+            throw std::invalid_argument("parameter grid must not be empty");
+        }
+        if (!(config.minDrawdown > 0.0))
+        {
+            throw std::invalid_argument("minDrawdown must be > 0");
+        }
+        const std::vector<WalkForwardFold> folds =
+            makeWalkForwardFolds(bars.size(), config.trainSize, config.testSize, config.scheme);
+        if (folds.empty())
+        {
+            throw std::invalid_argument("not enough bars for a single train/test fold");
+        }
+        std::vector<double> closes;
+        closes.reserve(bars.size());
+        for (const Bar &bar : bars)
+        {
+            if (bar.close <= 0.0)
+            {
+                throw std::invalid_argument("bar close must be > 0 to compute returns");
+            }
+            closes.push_back(bar.close);
+        }
+
+        const ReturnCalculator calc(config.periodsPerYear);
+        const std::size_t nTwma = config.twmaTimeConstants.size();
+        const std::size_t nVwma = config.vwmaWindows.size();
+
+        // 1) Indicator series over the full history, once per parameter value.
+        std::vector<std::vector<double>> twma(nTwma);
+        std::vector<std::vector<double>> vwma(nVwma);
+        parallelFor(nTwma + nVwma, config.threads, [&](std::size_t i)
+        {
+            if (i < nTwma)
+            {
+                TimeWeightedMovingAverage indicator(config.twmaTimeConstants[i]);
+                twma[i].reserve(bars.size());
+                for (const Bar &bar : bars)
+                {
+                    twma[i].push_back(indicator.update(bar));
+                }
+            }
+            else
+            {
+                vwma[i - nTwma] = VolumeWeightedMovingAverage::compute(bars, config.vwmaWindows[i - nTwma]);
+            }
+        });
+
+        // 2) Long-only crossover positions per grid point (NaN warm-up -> flat).
+        std::vector<std::vector<Position>> positions(grid.size());
+        parallelFor(grid.size(), config.threads, [&](std::size_t g)
+        {
+            positions[g] = crossoverPositions(twma[g / nVwma], vwma[g % nVwma]);
+        });
+
+        // 3) Score every grid point on every train fold. Closes were checked
+        //    above, so segment equity is positive and the kernels skip checks.
+        std::vector<double> trainScores(folds.size() * grid.size());
+        parallelFor(trainScores.size(), config.threads, [&](std::size_t task)
+        {
+            const WalkForwardFold &fold = folds[task / grid.size()];
+            const auto equity = segmentEquity(closes, positions[task % grid.size()], fold.trainBegin, fold.trainEnd);
+            trainScores[task] = scoreEquity(equity, config.metric, calc, InputCheck::Unchecked, config.minDrawdown);
+        });
+
+        // 4) Pick the best grid point per fold (first wins ties) and test it.
+        WalkForwardResult result;
+        result.folds.resize(folds.size());
+        std::vector<std::vector<double>> testEquity(folds.size());
+        parallelFor(folds.size(), config.threads, [&](std::size_t f)
+        {
+            std::size_t best = 0;
+            for (std::size_t g = 1; g < grid.size(); ++g)
+            {
+                if (trainScores[f * grid.size() + g] > trainScores[f * grid.size() + best])
+                {
+                    best = g;
+                }
+            }
+
+            // The test segment starts on the last train bar so that every
+            // out-of-sample return is covered exactly once.
+            const WalkForwardFold &fold = folds[f];
+            testEquity[f] = segmentEquity(closes, positions[best], fold.testBegin - 1, fold.testEnd);
+
+            FoldResult &out = result.folds[f];
+            out.fold = fold;
+            out.best = grid[best];
+            out.trainScore = trainScores[f * grid.size() + best];
+            out.testMetrics = calc.from_equity(testEquity[f], InputCheck::Unchecked);
+            out.testMaxDrawdown = max_drawdown(testEquity[f], InputCheck::Unchecked);
+        });
+
+        // 5) Chain the test segments into one out-of-sample curve.
+        result.outOfSampleEquity.push_back(1.0);
+        for (const auto &segment : testEquity)
+        {
+            const double base = result.outOfSampleEquity.back();
+            for (std::size_t i = 1; i < segment.size(); ++i)
+            {
+                result.outOfSampleEquity.push_back(base * segment[i]);
+            }
+        }
+
+        return result;
+    }
+
+} // namespace trading
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "core/bar.h"
+#include "core/input_check.h"
+#include "metrics/return_metrics.h"
+
+namespace trading
+{
+
+    enum class FoldScheme
+    {
+        Rolling, // fixed-length train window slides forward by the test length
+        Anchored // train window always starts at the first bar and grows
+    };
+
+    // Metric used to rank parameter sets on a train fold (higher score wins).
+    enum class SelectionMetric
+    {
+        CumulativeReturn,
+        AnnualizedReturn,
+        MaxDrawdown,       // scored as -max_drawdown
+        ReturnOverDrawdown // annualized_return / max(max_drawdown, minDrawdown)
+    };
+
+    // Drawdown floor of ReturnOverDrawdown. Smaller drawdowns (including none)
+    // count as 1%, so a flat or monotone train fold is ranked by its return
+    // instead of winning on a near-zero denominator.
+    constexpr double kDefaultMinDrawdown = 0.01;
+
+    // Half-open bar index ranges [begin, end).
+    struct WalkForwardFold
+    {
+        std::size_t trainBegin = 0;
+        std::size_t trainEnd = 0;
+        std::size_t testBegin = 0;
+        std::size_t testEnd = 0;
+    };
+
+    // One point of the parameter grid.
+    struct ParameterSet
+    {
+        double twmaTimeConstantDays = 0.0;
+        std::size_t vwmaWindow = 0;
+    };
+
+    struct WalkForwardConfig
+    {
+        std::vector<double> twmaTimeConstants;
+        std::vector<std::size_t> vwmaWindows;
+        std::size_t trainSize = 0;
+        std::size_t testSize = 0;
+        FoldScheme scheme = FoldScheme::Rolling;
+        SelectionMetric metric = SelectionMetric::ReturnOverDrawdown;
+        double minDrawdown = kDefaultMinDrawdown; // ReturnOverDrawdown floor, > 0
+        int periodsPerYear = 245;
+        std::size_t threads = 0; // 0 = all cores
+    };
+
+    struct FoldResult
+    {
+        WalkForwardFold fold;
+        ParameterSet best;
+        double trainScore = 0.0;
+        ReturnMetrics testMetrics;
+        double testMaxDrawdown = 0.0;
+    };
+
+    struct WalkForwardResult
+    {
+        std::vector<FoldResult> folds;
+        // Out-of-sample equity of the selected parameters, chained across test
+        // folds and starting at 1.0 on the bar before the first test fold.
+        std::vector<double> outOfSampleEquity;
+    };
+
+    // Split barCount bars into train/test folds. The last test fold may be shorter.
+    std::vector<WalkForwardFold> makeWalkForwardFolds(
+        std::size_t barCount,
+        std::size_t trainSize,
+        std::size_t testSize,
+        FoldScheme scheme);
+
+    // Grid of every TWMA time constant x VWMA window, TWMA-major.
+    std::vector<ParameterSet> makeParameterGrid(const WalkForwardConfig &config);
+
+    // Score of an equity curve under the given selection metric.
+    double scoreEquity(const std::vector<double> &equity,
+                       SelectionMetric metric,
+                       const ReturnCalculator &calc,
+                       InputCheck check = InputCheck::Checked,
+                       double minDrawdown = kDefaultMinDrawdown);
+
+    // Walk-forward optimisation of a TWMA/VWMA trend filter: long while the
+    // TWMA of closes is above the VWMA, flat otherwise (and during warm-up).
+    // The signal at bar i is applied to the close-to-close return i -> i+1.
+    //
+    // Each indicator series is computed once over the full history and shared
+    // by all folds and grid points, so overlapping folds never recompute
+    // indicator state. Train evaluations (fold x grid point) and test
+    // evaluations run in parallel.
+    WalkForwardResult runWalkForward(const std::vector<Bar> &bars, const WalkForwardConfig &config);
+
+} // namespace trading
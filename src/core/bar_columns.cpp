@@ -0,0 +1,115 @@
+#include "core/bar_columns.h"
+
+#include <limits>
+
+namespace trading
+{
+
+    void BarColumns::resize(std::size_t n)
+    {
+        symbolIds.resize(n);
+        periodIds.resize(n);
+        timestamps.resize(n);
+        open.resize(n);
+        high.resize(n);
+        low.resize(n);
+        close.resize(n);
+        volume.resize(n);
+        openInterest.resize(n);
+    }
+
+    BarColumns toColumns(const std::vector<Bar> &bars)
+    {
+        BarColumns columns;
+        columns.resize(bars.size());
+
+        SymbolTable &symbols = symbolTable();
+        SymbolTable &periods = periodTable();
+        for (std::size_t i = 0; i < bars.size(); ++i)
+        {
+            const Bar &bar = bars[i];
+            // Consecutive bars almost always share a symbol; skip the table then.
+            const bool sameAsPrevious = i > 0 && bar.symbol == bars[i - 1].symbol && bar.period == bars[i - 1].period;
+            columns.symbolIds[i] = sameAsPrevious ? columns.symbolIds[i - 1] : symbols.intern(bar.symbol);
+            columns.periodIds[i] = sameAsPrevious ? columns.periodIds[i - 1] : periods.intern(bar.period);
+            columns.timestamps[i] = toEpochSeconds(bar.date, bar.time);
+            columns.open[i] = bar.open;
+            columns.high[i] = bar.high;
+            columns.low[i] = bar.low;
+            columns.close[i] = bar.close;
+            columns.volume[i] = bar.volume;
+            columns.openInterest[i] = bar.openInterest;
+        }
+
+        return columns;
+    }
+
+    std::vector<Bar> toBars(const BarColumns &columns)
+    {
+        const SymbolTable &symbols = symbolTable();
+        const SymbolTable &periods = periodTable();
+
+        std::vector<Bar> bars;
+        bars.reserve(columns.size());
+        for (std::size_t i = 0; i < columns.size(); ++i)
+        {
+            bars.push_back(Bar{
+                symbols.name(columns.symbolIds[i]),
+                periods.name(columns.periodIds[i]),
+                formatDate(columns.timestamps[i]),
+                formatTime(columns.timestamps[i]),
+                columns.open[i],
+                columns.high[i],
+                columns.low[i],
+                columns.close[i],
+                columns.volume[i],
+                columns.openInterest[i]});
+        }
+        return bars;
+    }
+
+    std::vector<SymbolRows> groupBySymbol(const BarColumns &columns)
+    {
+        // Ids are dense, so a flat array replaces a hash map keyed by name.
+        constexpr std::size_t kNoGroup = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> groupOf;
+        std::vector<SymbolRows> groups;
+
+        for (std::size_t i = 0; i < columns.size(); ++i)
+        {
+            const SymbolId id = columns.symbolIds[i];
+            if (id >= groupOf.size())
+            {
+                groupOf.resize(static_cast<std::size_t>(id) + 1, kNoGroup);
+            }
+            if (groupOf[id] == kNoGroup)
+            {
+                groupOf[id] = groups.size();
+                groups.push_back(SymbolRows{id, {}});
+            }
+            groups[groupOf[id]].rows.push_back(i);
+        }
+        return groups;
+    }
+
+    BarColumns selectRows(const BarColumns &columns, const std::vector<std::size_t> &rows)
+    {
+        BarColumns out;
+        out.resize(rows.size());
+        for (std::size_t i = 0; i < rows.size(); ++i)
+        {
+            const std::size_t r = rows[i];
+            out.symbolIds[i] = columns.symbolIds[r];
+            out.periodIds[i] = columns.periodIds[r];
+            out.timestamps[i] = columns.timestamps[r];
+            out.open[i] = columns.open[r];
+            out.high[i] = columns.high[r];
+            out.low[i] = columns.low[r];
+            out.close[i] = columns.close[r];
+            out.volume[i] = columns.volume[r];
+            out.openInterest[i] = columns.openInterest[r];
+        }
+        return out;
+    }
+
+} // namespace trading
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "core/bar.h"
+#include "core/symbol_table.h"
+#include "core/timestamp.h"
+
+namespace trading
+{
+
+    // Column-oriented view of a bar series. Each vector has size() entries.
+    // Kernels that only need prices can work on the double columns directly.
+    // Tickers and period codes are stored as ids into symbolTable() and
+    // periodTable(); names are looked up only when converting back to Bars.
+    struct BarColumns
+    {
+        std::vector<SymbolId> symbolIds;
+        std::vector<SymbolId> periodIds;
+        std::vector<EpochSeconds> timestamps;
+        std::vector<double> open;
+        std::vector<double> high;
+        std::vector<double> low;
+        std::vector<double> close;
+        std::vector<double> volume;
+        std::vector<std::uint64_t> openInterest;
+
+        std::size_t size() const noexcept { return timestamps.size(); }
+
+        // Resize every column to n entries.
+        void resize(std::size_t n);
+    };
+
+    // Split bars into columns. Dates/times are converted to epoch seconds.
+    BarColumns toColumns(const std::vector<Bar> &bars);
+
+    // Rebuild Bars from columns, resolving symbol and period ids to names.
+    std::vector<Bar> toBars(const BarColumns &columns);
+
+    // Row indices of one symbol, in row order.
+    struct SymbolRows
+    {
+        SymbolId symbol = 0;
+        std::vector<std::size_t> rows;
+    };
+
+    // Group rows by symbol id, in order of first appearance.
+    std::vector<SymbolRows> groupBySymbol(const BarColumns &columns);
+
+    // Copy of the given rows, in the given order.
+    BarColumns selectRows(const BarColumns &columns, const std::vector<std::size_t> &rows);
+
+} // namespace trading
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace trading
+{
+
+    // Whether a kernel validates every element of its input.
+    // Unchecked is for data that already passed validateBars()/cleanBars():
+    // the kernel then skips its per-element checks (size checks stay) and
+    // behaviour on invalid values is unspecified.
+    enum class InputCheck
+    {
+        Checked,
+        Unchecked
+    };
+
+} // namespace trading
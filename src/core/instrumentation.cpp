@@ -0,0 +1,398 @@
+#include "core/instrumentation.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(TRADING_INSTRUMENTATION_TSC) && defined(__x86_64__)
+#include <thread>
+#include <x86intrin.h>
+#endif
+
+namespace trading
+{
+    namespace instrumentation
+    {
+        namespace
+        {
+            struct Aggregate
+            {
+                std::uint64_t count = 0;
+                std::uint64_t sum = 0;
+                std::uint64_t max = 0;
+                std::uint64_t buckets[kHistogramBuckets]{};
+            };
+
+            struct Registry
+            {
+                std::mutex mutex;
+                // Thread states outlive their threads so data can be exported
+                // after workers have joined; idle ones are reused by new threads.
+                std::vector<std::unique_ptr<ThreadState>> threads;
+                std::vector<ThreadState *> idle;
+                Aggregate retired[kMaxProbes]; // stats of exited threads
+                const char *names[kMaxProbes]{};
+                ProbeKind kinds[kMaxProbes]{};
+                std::size_t probeCount = 0;
+                std::uint32_t nextThreadId = 1; // trace tid of the next owner
+            };
+
+            Registry &registry()
+            {
+                static Registry instance;
+                return instance;
+            }
+
+            ThreadState *acquireThread()
+            {
+                Registry &r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                ThreadState *state = nullptr;
+                if (!r.idle.empty())
+                {
+                    state = r.idle.back();
+                    r.idle.pop_back();
+                }
+                else
+                {
+                    r.threads.push_back(std::make_unique<ThreadState>());
+                    state = r.threads.back().get();
+                }
+                // A reused state still holds its previous owner's events; a new
+                // id keeps the two threads apart in the trace.
+                state->threadId = r.nextThreadId++;
+                return state;
+            }
+
+            void clearStats(ProbeStats &stats)
+            {
+                stats.count.store(0, std::memory_order_relaxed);
+                stats.sum.store(0, std::memory_order_relaxed);
+                stats.max.store(0, std::memory_order_relaxed);
+                for (auto &bucket : stats.buckets)
+                {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+            }
+
+            void addStats(Aggregate &a, const ProbeStats &s)
+            {
+                a.count += s.count.load(std::memory_order_relaxed);
+                a.sum += s.sum.load(std::memory_order_relaxed);
+                a.max = std::max(a.max, s.max.load(std::memory_order_relaxed));
+                for (std::size_t b = 0; b < kHistogramBuckets; ++b)
+                {
+                    a.buckets[b] += s.buckets[b].load(std::memory_order_relaxed);
+                }
+            }
+
+            // Folds an exiting thread's stats into the retired totals and returns
+            // its state to the pool.
+            void releaseThread(ThreadState *state)
+            {
+                Registry &r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                for (std::size_t p = 0; p < r.probeCount; ++p)
+                {
+                    addStats(r.retired[p], state->probes[p]);
+                    clearStats(state->probes[p]);
+                }
+                r.idle.push_back(state);
+            }
+
+            struct ThreadHandle
+            {
+                ThreadState *state = acquireThread();
+
+                ~ThreadHandle()
+                {
+                    releaseThread(state);
+                }
+            };
+
+            // Upper bound of the histogram bucket holding the q-quantile.
+            std::uint64_t quantile(const Aggregate &a, double q)
+            {
+                if (a.count == 0)
+                {
+                    return 0;
+                }
+                const auto target = static_cast<std::uint64_t>(q * static_cast<double>(a.count - 1)) + 1;
+                std::uint64_t seen = 0;
+                for (std::size_t b = 0; b < kHistogramBuckets; ++b)
+                {
+                    seen += a.buckets[b];
+                    if (seen >= target)
+                    {
+                        return std::min(a.max, (b == 0) ? 0 : ((std::uint64_t{1} << b) - 1));
+                    }
+                }
+                return a.max;
+            }
+
+            void writeJsonString(std::ostream &out, const char *s)
+            {
+                out << '"';
+                for (; *s != '\0'; ++s)
+                {
+                    if (*s == '"' || *s == '\\')
+                    {
+                        out << '\\';
+                    }
+                    out << *s;
+                }
+                out << '"';
+            }
+        } // namespace
+
+#if defined(TRADING_INSTRUMENTATION_TSC) && defined(__x86_64__)
+        namespace
+        {
+            struct TscClock
+            {
+                std::uint64_t origin;
+                double nsPerTick;
+            };
+
+            // Calibrates TSC ticks against steady_clock (sleeps 10 ms).
+            const TscClock &tscClock()
+            {
+                static const TscClock clock = []
+                {
+                    const auto t0 = std::chrono::steady_clock::now();
+                    const std::uint64_t c0 = __rdtsc();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    const std::uint64_t c1 = __rdtsc();
+                    const auto t1 = std::chrono::steady_clock::now();
+                    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+                    return TscClock{c0, static_cast<double>(ns) / static_cast<double>(c1 - c0)};
+                }();
+                return clock;
+            }
+
+            // Calibrate during static initialisation rather than in the first probe.
+            [[maybe_unused]] const TscClock &startupCalibration = tscClock();
+        } // namespace
+#endif
+
+        std::uint64_t nowNs() noexcept
+        {
+#if defined(TRADING_INSTRUMENTATION_TSC) && defined(__x86_64__)
+            const TscClock &clock = tscClock();
+            return static_cast<std::uint64_t>(static_cast<double>(__rdtsc() - clock.origin) * clock.nsPerTick);
+#else
+            static const auto origin = std::chrono::steady_clock::now();
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count());
+#endif
+        }
+
+        std::size_t registerProbe(const char *name, ProbeKind kind)
+        {
+            Registry &r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+
+            // Call sites that share a name share a probe.
+            for (std::size_t i = 0; i < r.probeCount; ++i)
+            {
+                if (r.kinds[i] == kind && std::strcmp(r.names[i], name) == 0)
+                {
+                    return i;
+                }
+            }
+
+            if (r.probeCount == kMaxProbes)
+            {
+                throw std::length_error("too many instrumentation probes");
+            }
+            r.names[r.probeCount] = name;
+            r.kinds[r.probeCount] = kind;
+            return r.probeCount++;
+        }
+
+        ThreadState &threadState()
+        {
+            thread_local ThreadHandle handle;
+            return *handle.state;
+        }
+
+        std::size_t threadStateCount()
+        {
+            Registry &r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            return r.threads.size();
+        }
+
+        void recordDuration(std::size_t probe, std::uint64_t startNs, std::uint64_t durationNs) noexcept
+        {
+            ThreadState &state = threadState();
+
+            ProbeStats &stats = state.probes[probe];
+            bump(stats.count, 1);
+            bump(stats.sum, durationNs);
+            if (durationNs > stats.max.load(std::memory_order_relaxed))
+            {
+                stats.max.store(durationNs, std::memory_order_relaxed);
+            }
+            const auto bucket = std::min<std::size_t>(std::bit_width(durationNs), kHistogramBuckets - 1);
+            bump(stats.buckets[bucket], 1);
+
+            const std::size_t index = state.eventCount.load(std::memory_order_relaxed);
+            if (index < kEventsPerThread)
+            {
+                if (!state.events)
+                {
+                    // Only threads that record scopes pay for the event buffer.
+                    state.events.reset(new (std::nothrow) TraceEvent[kEventsPerThread]);
+                    if (!state.events)
+                    {
+                        bump(state.droppedEvents, 1);
+                        return;
+                    }
+                }
+                state.events[index] = TraceEvent{static_cast<std::uint32_t>(probe), state.threadId, startNs, durationNs};
+                state.eventCount.store(index + 1, std::memory_order_release);
+            }
+            else
+            {
+                bump(state.droppedEvents, 1);
+            }
+        }
+
+        void writeChromeTrace(std::ostream &out)
+        {
+            Registry &r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+
+            out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            bool first = true;
+            auto separator = [&]
+            {
+                if (!first)
+                {
+                    out << ",\n";
+                }
+                first = false;
+            };
+
+            out << std::fixed << std::setprecision(3);
+            for (const auto &thread : r.threads)
+            {
+                const std::size_t n = thread->eventCount.load(std::memory_order_acquire);
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const TraceEvent &e = thread->events[i];
+                    separator();
+                    out << "{\"name\":";
+                    writeJsonString(out, r.names[e.probe]);
+                    out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.threadId
+                        << ",\"ts\":" << static_cast<double>(e.startNs) / 1000.0
+                        << ",\"dur\":" << static_cast<double>(e.durationNs) / 1000.0 << '}';
+                }
+            }
+
+            // Counters are emitted once with their totals at export time.
+            const double exportTs = static_cast<double>(nowNs()) / 1000.0;
+            for (std::size_t p = 0; p < r.probeCount; ++p)
+            {
+                if (r.kinds[p] != ProbeKind::Counter)
+                {
+                    continue;
+                }
+                std::uint64_t total = r.retired[p].sum;
+                for (const auto &thread : r.threads)
+                {
+                    total += thread->probes[p].sum.load(std::memory_order_relaxed);
+                }
+                separator();
+                out << "{\"name\":";
+                writeJsonString(out, r.names[p]);
+                out << ",\"ph\":\"C\",\"pid\":1,\"ts\":" << exportTs << ",\"args\":{\"value\":" << total << "}}";
+            }
+            out << "]}\n";
+        }
+
+        void writeChromeTrace(const std::filesystem::path &path)
+        {
+            std::ofstream out(path);
+            if (!out.is_open())
+            {
+                throw std::runtime_error("Failed to open trace file: " + path.string());
+            }
+            writeChromeTrace(out);
+        }
+
+        void writeSummary(std::ostream &out)
+        {
+            Registry &r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+
+            std::uint64_t dropped = 0;
+            for (const auto &thread : r.threads)
+            {
+                dropped += thread->droppedEvents.load(std::memory_order_relaxed);
+            }
+
+            out << std::left << std::setw(36) << "probe" << std::right
+                << std::setw(12) << "count" << std::setw(14) << "total_us"
+                << std::setw(12) << "mean_ns" << std::setw(12) << "p50_ns"
+                << std::setw(12) << "p99_ns" << std::setw(12) << "max_ns" << '\n';
+
+            for (std::size_t p = 0; p < r.probeCount; ++p)
+            {
+                Aggregate a = r.retired[p];
+                for (const auto &thread : r.threads)
+                {
+                    addStats(a, thread->probes[p]);
+                }
+
+                out << std::left << std::setw(36) << r.names[p] << std::right << std::setw(12) << a.count;
+                if (r.kinds[p] == ProbeKind::Counter)
+                {
+                    out << "  total=" << a.sum << '\n';
+                    continue;
+                }
+
+                const std::uint64_t mean = (a.count > 0) ? a.sum / a.count : 0;
+                out << std::setw(14) << a.sum / 1000 << std::setw(12) << mean
+                    << std::setw(12) << quantile(a, 0.50) << std::setw(12) << quantile(a, 0.99)
+                    << std::setw(12) << a.max << '\n';
+            }
+
+            if (dropped > 0)
+            {
+                out << "dropped trace events: " << dropped << '\n';
+            }
+        }
+
+        void reset()
+        {
+            Registry &r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (auto &retired : r.retired)
+            {
+                retired = Aggregate{};
+            }
+            for (auto &thread : r.threads)
+            {
+                for (auto &stats : thread->probes)
+                {
+                    clearStats(stats);
+                }
+                thread->eventCount.store(0, std::memory_order_release);
+                thread->droppedEvents.store(0, std::memory_order_relaxed);
+            }
+        }
+
+    } // namespace instrumentation
+} // namespace trading
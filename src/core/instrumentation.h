@@ -0,0 +1,158 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+
+// Hot-path timing and counters.
+//
+// Build with TRADING_INSTRUMENTATION=0 to compile every TRADING_* macro below
+// to nothing. The functions stay available so exporters can still be called,
+// they just report no data.
+#ifndef TRADING_INSTRUMENTATION
+#define TRADING_INSTRUMENTATION 1
+#endif
+
+namespace trading
+{
+    namespace instrumentation
+    {
+        constexpr std::size_t kMaxProbes = 256;         // distinct scope/counter names
+        constexpr std::size_t kHistogramBuckets = 64;   // log2(ns) buckets
+        constexpr std::size_t kEventsPerThread = 1 << 16;
+
+        enum class ProbeKind : std::uint8_t
+        {
+            Scope,
+            Counter
+        };
+
+        // Monotonic clock in nanoseconds since the first call in this process.
+        // Uses the TSC on x86-64 when TRADING_INSTRUMENTATION_TSC is defined
+        // (CMake option of the same name), otherwise std::chrono::steady_clock.
+        std::uint64_t nowNs() noexcept;
+
+        // Register a probe name (a string literal) and return its id.
+        // Called once per call site through a function-local static.
+        std::size_t registerProbe(const char *name, ProbeKind kind);
+
+        // Per-thread counters and duration histograms. Only the owning thread
+        // writes, so updates are plain relaxed load/store pairs (no locked
+        // instructions); exporters may read them concurrently.
+        struct ProbeStats
+        {
+            std::atomic<std::uint64_t> count{0};
+            std::atomic<std::uint64_t> sum{0};
+            std::atomic<std::uint64_t> max{0};
+            std::atomic<std::uint64_t> buckets[kHistogramBuckets]{};
+        };
+
+        struct TraceEvent
+        {
+            std::uint32_t probe;
+            std::uint32_t threadId; // of the thread that recorded it
+            std::uint64_t startNs;
+            std::uint64_t durationNs;
+        };
+
+        // Per-thread probe data. When a thread exits its stats are folded into a
+        // process-wide aggregate and the state is handed to the next new thread,
+        // so short-lived worker threads do not grow memory. Trace events stay in
+        // the state (the next owner appends after them); each owner gets a fresh
+        // threadId, and every event keeps the id of the thread that recorded it.
+        struct ThreadState
+        {
+            std::uint32_t threadId = 0; // of the current owner
+            ProbeStats probes[kMaxProbes];
+            std::unique_ptr<TraceEvent[]> events; // kEventsPerThread, allocated on first scope
+            std::atomic<std::size_t> eventCount{0};
+            std::atomic<std::uint64_t> droppedEvents{0};
+        };
+
+        // State of the calling thread, taken from the pool on first use.
+        ThreadState &threadState();
+
+        // Number of thread states allocated so far (peak concurrent probed threads).
+        std::size_t threadStateCount();
+
+        inline void bump(std::atomic<std::uint64_t> &v, std::uint64_t n) noexcept
+        {
+            v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        inline void addCount(std::size_t probe, std::uint64_t n) noexcept
+        {
+            ProbeStats &stats = threadState().probes[probe];
+            bump(stats.count, 1);
+            bump(stats.sum, n);
+        }
+
+        void recordDuration(std::size_t probe, std::uint64_t startNs, std::uint64_t durationNs) noexcept;
+
+        // Records the lifetime of a scope as a trace event and a histogram sample.
+        class ScopedTimer
+        {
+        public:
+            explicit ScopedTimer(std::size_t probe) noexcept
+                : probe_(probe), start_(nowNs())
+            {
+            }
+
+            ~ScopedTimer()
+            {
+                recordDuration(probe_, start_, nowNs() - start_);
+            }
+
+            ScopedTimer(const ScopedTimer &) = delete;
+            ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+        private:
+            std::size_t probe_;
+            std::uint64_t start_;
+        };
+
+        // Write all recorded scopes as Chrome trace / Perfetto JSON.
+        void writeChromeTrace(std::ostream &out);
+        void writeChromeTrace(const std::filesystem::path &path);
+
+        // Write a per-probe text table (count, total, mean, p50, p99, max).
+        void writeSummary(std::ostream &out);
+
+        // Clear all recorded data. Only call while no instrumented code runs.
+        void reset();
+
+    } // namespace instrumentation
+} // namespace trading
+
+#define TRADING_INSTR_CONCAT_IMPL(a, b) a##b
+#define TRADING_INSTR_CONCAT(a, b) TRADING_INSTR_CONCAT_IMPL(a, b)
+
+#if TRADING_INSTRUMENTATION
+
+// Time the enclosing scope under the given string-literal name.
+#define TRADING_TRACE_SCOPE(name)                                                                            \
+    static const std::size_t TRADING_INSTR_CONCAT(trading_probe_, __LINE__) =                                \
+        ::trading::instrumentation::registerProbe(name, ::trading::instrumentation::ProbeKind::Scope);        \
+    const ::trading::instrumentation::ScopedTimer TRADING_INSTR_CONCAT(trading_timer_, __LINE__)               \
+    {                                                                                                        \
+        TRADING_INSTR_CONCAT(trading_probe_, __LINE__)                                                       \
+    }
+
+// Add n to the named counter of the calling thread.
+#define TRADING_COUNTER_ADD(name, n)                                                                         \
+    do                                                                                                       \
+    {                                                                                                        \
+        static const std::size_t trading_probe_ =                                                            \
+            ::trading::instrumentation::registerProbe(name, ::trading::instrumentation::ProbeKind::Counter);  \
+        ::trading::instrumentation::addCount(trading_probe_, static_cast<std::uint64_t>(n));                 \
+    } while (false)
+
+#else
+
+#define TRADING_TRACE_SCOPE(name) static_cast<void>(0)
+#define TRADING_COUNTER_ADD(name, n) static_cast<void>(0)
+
+#endif
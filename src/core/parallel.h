@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace trading
+{
+
+    // Number of worker threads to use when the caller passes 0.
+    inline std::size_t defaultThreadCount() noexcept
+    {
+        const unsigned hw = std::thread::hardware_concurrency();
+        return (hw > 0) ? hw : 1;
+    }
+
+    // Run fn(i) for every i in [0, count) on up to `threads` threads (0 = all cores).
+    // Work is handed out dynamically one index at a time, so uneven tasks balance.
+    // The first exception thrown by fn is rethrown on the calling thread after
+    // all workers have stopped.
+    template <typename Fn>
+    void parallelFor(std::size_t count, std::size_t threads, Fn &&fn)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        if (threads == 0)
+        {
+            threads = defaultThreadCount();
+        }
+        threads = std::min(threads, count);
+
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        auto worker = [&]
+        {
+            while (!failed.load(std::memory_order_relaxed))
+            {
+                const std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= count)
+                {
+                    return;
+                }
+                try
+                {
+                    fn(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (std::size_t t = 1; t < threads; ++t)
+        {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto &th : pool)
+        {
+            th.join();
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+} // namespace trading
@@ -0,0 +1,78 @@
+#include "core/symbol_table.h"
+
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+namespace trading
+{
+
+    SymbolId SymbolTable::intern(std::string_view name)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            const auto it = index_.find(name);
+            if (it != index_.end())
+            {
+                return it->second;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        // Another thread may have added it between the two locks.
+        const auto it = index_.find(name);
+        if (it != index_.end())
+        {
+            return it->second;
+        }
+        if (names_.size() == std::numeric_limits<SymbolId>::max())
+        {
+            throw std::length_error("symbol table is full");
+        }
+
+        const auto id = static_cast<SymbolId>(names_.size());
+        names_.emplace_back(name);
+        index_.emplace(names_.back(), id);
+        return id;
+    }
+
+    std::optional<SymbolId> SymbolTable::find(std::string_view name) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        const auto it = index_.find(name);
+        if (it == index_.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    const std::string &SymbolTable::name(SymbolId id) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        if (id >= names_.size())
+        {
+            throw std::out_of_range("unknown symbol id " + std::to_string(id));
+        }
+        return names_[id];
+    }
+
+    std::size_t SymbolTable::size() const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return names_.size();
+    }
+
+    SymbolTable &symbolTable()
+    {
+        static SymbolTable table;
+        return table;
+    }
+
+    SymbolTable &periodTable()
+    {
+        static SymbolTable table;
+        return table;
+    }
+
+} // namespace trading
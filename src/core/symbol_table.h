@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace trading
+{
+
+    // Dense integer id of an interned string (0, 1, 2, ... in order of first use).
+    using SymbolId = std::uint32_t;
+
+    // Thread-safe string interning table. Lookups take a shared lock; only the
+    // first occurrence of a new name takes the exclusive lock. Ids and the
+    // strings they refer to stay valid for the lifetime of the table.
+    class SymbolTable
+    {
+    public:
+        SymbolTable() = default;
+        SymbolTable(const SymbolTable &) = delete;
+        SymbolTable &operator=(const SymbolTable &) = delete;
+
+        // Id of name, adding it if it is new.
+        SymbolId intern(std::string_view name);
+
+        // Id of name if it has been interned.
+        std::optional<SymbolId> find(std::string_view name) const;
+
+        // Name of an id (throws std::out_of_range for unknown ids).
+        const std::string &name(SymbolId id) const;
+
+        std::size_t size() const;
+
+    private:
+        mutable std::shared_mutex mutex_;
+        std::deque<std::string> names_; // deque keeps element addresses stable
+        std::unordered_map<std::string_view, SymbolId> index_; // views into names_
+    };
+
+    // Process-wide tables for tickers (<TICKER>) and period codes (<PER>).
+    SymbolTable &symbolTable();
+    SymbolTable &periodTable();
+
+} // namespace trading
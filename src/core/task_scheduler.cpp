@@ -0,0 +1,268 @@
+#include "core/task_scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+#include "core/instrumentation.h"
+
+namespace trading
+{
+    namespace
+    {
+        // Both are written on every task by their own worker; keep neighbours
+        // in the per-run vectors on separate cache lines.
+        struct alignas(64) TaskQueue
+        {
+            std::mutex mutex;
+            std::deque<std::size_t> tasks;
+
+            std::optional<std::size_t> popBack()
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (tasks.empty())
+                {
+                    return std::nullopt;
+                }
+                const std::size_t task = tasks.back();
+                tasks.pop_back();
+                return task;
+            }
+
+            std::optional<std::size_t> stealFront()
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (tasks.empty())
+                {
+                    return std::nullopt;
+                }
+                const std::size_t task = tasks.front();
+                tasks.pop_front();
+                return task;
+            }
+        };
+
+        struct alignas(64) WorkerCounters
+        {
+            std::size_t tasks = 0;
+            std::size_t localSteals = 0;
+            std::size_t remoteSteals = 0;
+            std::chrono::steady_clock::duration busy{};
+        };
+    } // namespace
+
+    double NodeStats::throughput() const noexcept
+    {
+        return (busySeconds > 0.0) ? static_cast<double>(tasks) / busySeconds : 0.0;
+    }
+
+    TaskScheduler::TaskScheduler(CpuTopology topology, TaskSchedulerConfig config)
+        : topology_(std::move(topology)), config_(config)
+    {
+        if (topology_.nodes.empty() || topology_.cpuCount() == 0)
+        {
+            throw std::invalid_argument("TaskScheduler needs at least one CPU");
+        }
+
+        const std::size_t nodeCount = topology_.nodes.size();
+        const std::size_t threads = (config_.threads == 0) ? topology_.cpuCount() : config_.threads;
+
+        // Interleave workers over nodes so partial pools still use every socket.
+        workers_.resize(threads);
+        std::vector<std::size_t> used(nodeCount, 0);
+        for (std::size_t w = 0; w < threads; ++w)
+        {
+            std::size_t node = w % nodeCount;
+            // Skip to the next node when this one has run out of CPUs.
+            for (std::size_t k = 0; k < nodeCount && used[node] >= topology_.nodes[node].cpus.size(); ++k)
+            {
+                node = (node + 1) % nodeCount;
+            }
+            const auto &cpus = topology_.nodes[node].cpus;
+            workers_[w].node = node;
+            workers_[w].cpu = cpus[used[node] % cpus.size()];
+            ++used[node];
+        }
+
+        std::vector<std::vector<std::size_t>> byNode(nodeCount);
+        for (std::size_t w = 0; w < threads; ++w)
+        {
+            byNode[workers_[w].node].push_back(w);
+        }
+        for (auto &nodeWorkers : byNode)
+        {
+            if (!nodeWorkers.empty())
+            {
+                nodeWorkers_.push_back(std::move(nodeWorkers));
+            }
+        }
+
+        for (std::size_t w = 0; w < threads; ++w)
+        {
+            auto &victims = workers_[w].victims;
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                for (std::size_t k = 1; k < threads; ++k)
+                {
+                    const std::size_t v = (w + k) % threads;
+                    const bool sameNode = workers_[v].node == workers_[w].node;
+                    if (sameNode == (pass == 0))
+                    {
+                        victims.push_back(v);
+                    }
+                }
+            }
+        }
+
+        pinned_.assign(threads, 0);
+        pool_ = std::make_unique<ThreadPool>(threads, [this](std::size_t w)
+        {
+            if (config_.pinThreads)
+            {
+                pinned_[w] = pinCurrentThread(workers_[w].cpu) ? 1 : 0;
+            }
+        });
+    }
+
+    TaskScheduler::~TaskScheduler() = default;
+
+    int TaskScheduler::workerNode(std::size_t worker) const
+    {
+        if (worker >= workers_.size())
+        {
+            throw std::out_of_range("worker index out of range");
+        }
+        return topology_.nodes[workers_[worker].node].id;
+    }
+
+    std::size_t TaskScheduler::homeWorker(std::size_t key) const noexcept
+    {
+        const auto &nodeWorkers = nodeWorkers_[key % nodeWorkers_.size()];
+        return nodeWorkers[(key / nodeWorkers_.size()) % nodeWorkers.size()];
+    }
+
+    SchedulerStats TaskScheduler::run(std::size_t count, const std::function<void(std::size_t, std::size_t)> &task)
+    {
+        std::vector<std::size_t> home(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            home[i] = i % workers_.size();
+        }
+        return run(count, home, task);
+    }
+
+    SchedulerStats TaskScheduler::run(std::size_t count,
+                                      const std::vector<std::size_t> &home,
+                                      const std::function<void(std::size_t, std::size_t)> &task,
+                                      Stealing stealing)
+    {
+        TRADING_TRACE_SCOPE("TaskScheduler::run");
+
+        if (home.size() != count)
+        {
+            throw std::invalid_argument("home must have one worker per task");
+        }
+
+        const std::size_t threads = workers_.size();
+        std::vector<TaskQueue> queues(threads);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (home[i] >= threads)
+            {
+                throw std::out_of_range("home worker index out of range");
+            }
+            queues[home[i]].tasks.push_back(i);
+        }
+
+        std::vector<WorkerCounters> counters(threads);
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        const std::size_t victimLimit = (stealing == Stealing::Allowed) ? threads : 0;
+        auto worker = [&](std::size_t w)
+        {
+            const WorkerSlot &slot = workers_[w];
+            WorkerCounters &mine = counters[w];
+            const std::size_t victims = std::min(victimLimit, slot.victims.size());
+
+            while (!failed.load(std::memory_order_relaxed))
+            {
+                std::optional<std::size_t> next = queues[w].popBack();
+                for (std::size_t k = 0; !next && k < victims; ++k)
+                {
+                    const std::size_t v = slot.victims[k];
+                    next = queues[v].stealFront();
+                    if (next)
+                    {
+                        const bool local = workers_[v].node == slot.node;
+                        ++(local ? mine.localSteals : mine.remoteSteals);
+                    }
+                }
+                // Tasks are never added during a run, so empty everywhere means done.
+                if (!next)
+                {
+                    return;
+                }
+
+                const auto start = std::chrono::steady_clock::now();
+                try
+                {
+                    task(*next, w);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    failed.store(true, std::memory_order_relaxed);
+                }
+                mine.busy += std::chrono::steady_clock::now() - start;
+                ++mine.tasks;
+            }
+        };
+
+        const auto wallStart = std::chrono::steady_clock::now();
+        pool_->runOnEach(worker);
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+
+        SchedulerStats stats;
+        stats.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+        stats.nodes.resize(topology_.nodes.size());
+        for (std::size_t n = 0; n < topology_.nodes.size(); ++n)
+        {
+            stats.nodes[n].node = topology_.nodes[n].id;
+        }
+        std::size_t localSteals = 0;
+        std::size_t remoteSteals = 0;
+        for (std::size_t w = 0; w < threads; ++w)
+        {
+            NodeStats &node = stats.nodes[workers_[w].node];
+            const WorkerCounters &c = counters[w];
+            ++node.workers;
+            node.pinnedWorkers += (pinned_[w] != 0);
+            node.tasks += c.tasks;
+            node.localSteals += c.localSteals;
+            node.remoteSteals += c.remoteSteals;
+            node.busySeconds += std::chrono::duration<double>(c.busy).count();
+            localSteals += c.localSteals;
+            remoteSteals += c.remoteSteals;
+        }
+        TRADING_COUNTER_ADD("scheduler.tasks", count);
+        TRADING_COUNTER_ADD("scheduler.localSteals", localSteals);
+        TRADING_COUNTER_ADD("scheduler.remoteSteals", remoteSteals);
+        return stats;
+    }
+
+} // namespace trading
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "core/thread_pool.h"
+#include "core/topology.h"
+
+namespace trading
+{
+
+    struct TaskSchedulerConfig
+    {
+        std::size_t threads = 0; // 0 = one worker per CPU in the topology
+        bool pinThreads = true;  // pin each worker to its CPU
+    };
+
+    // Whether idle workers may take tasks queued on other workers.
+    enum class Stealing
+    {
+        Allowed,
+        Disabled, // every task runs on its home worker, e.g. for first-touch placement
+    };
+
+    // Per-node counters of one TaskScheduler::run.
+    struct NodeStats
+    {
+        int node = 0;
+        std::size_t workers = 0;
+        std::size_t pinnedWorkers = 0;
+        std::size_t tasks = 0;        // tasks executed by this node's workers
+        std::size_t localSteals = 0;  // taken from a worker on the same node
+        std::size_t remoteSteals = 0; // taken from a worker on another node
+        double busySeconds = 0.0;     // summed over workers
+
+        // Tasks per busy worker-second.
+        double throughput() const noexcept;
+    };
+
+    struct SchedulerStats
+    {
+        std::vector<NodeStats> nodes;
+        double wallSeconds = 0.0;
+    };
+
+    // Work-stealing scheduler over a NUMA topology.
+    //
+    // Workers are spread round-robin over the nodes. Their threads are started
+    // and (optionally) pinned to one CPU each by the constructor, then reused
+    // by every run() until the scheduler is destroyed. Every worker owns a
+    // deque of task indices; it pops its own tasks newest first and, once
+    // empty, steals the oldest task of another worker, trying workers on its
+    // own node before crossing to other nodes. On a single-node machine this
+    // is plain work stealing.
+    //
+    // Tasks should allocate the data they work on themselves: with pinned
+    // workers, first-touch places those pages on the executing node.
+    class TaskScheduler
+    {
+    public:
+        explicit TaskScheduler(CpuTopology topology = CpuTopology::detect(), TaskSchedulerConfig config = {});
+        ~TaskScheduler(); // stops and joins the workers
+
+        std::size_t workerCount() const noexcept { return workers_.size(); }
+        const CpuTopology &topology() const noexcept { return topology_; }
+
+        // Node a worker belongs to.
+        int workerNode(std::size_t worker) const;
+
+        // Stable owner of tasks keyed by key (e.g. a symbol id): the key picks a
+        // node, then a worker on that node. The mapping depends only on the
+        // topology and worker count, so it is the same for every run.
+        std::size_t homeWorker(std::size_t key) const noexcept;
+
+        // Run task(index, worker) for every index in [0, count) and wait.
+        // Task i is queued on worker i % workerCount(). The first exception
+        // thrown by a task is rethrown here after all workers have stopped.
+        // Concurrent runs are serialised; a task must not call run() itself.
+        SchedulerStats run(std::size_t count, const std::function<void(std::size_t, std::size_t)> &task);
+
+        // As above, but task i is queued on worker home[i]. It still runs
+        // elsewhere if it is stolen, unless stealing is Disabled. home must
+        // have count entries.
+        SchedulerStats run(std::size_t count,
+                           const std::vector<std::size_t> &home,
+                           const std::function<void(std::size_t, std::size_t)> &task,
+                           Stealing stealing = Stealing::Allowed);
+
+    private:
+        struct WorkerSlot
+        {
+            std::size_t node = 0; // index into topology_.nodes
+            int cpu = 0;
+            std::vector<std::size_t> victims; // same node first, then other nodes
+        };
+
+        CpuTopology topology_;
+        TaskSchedulerConfig config_;
+        std::vector<WorkerSlot> workers_;
+        std::vector<std::vector<std::size_t>> nodeWorkers_; // per node that has workers
+        std::vector<char> pinned_;                         // set once by each worker thread
+        std::unique_ptr<ThreadPool> pool_;                 // one thread per worker
+    };
+
+} // namespace trading
@@ -0,0 +1,148 @@
+#include "core/thread_pool.h"
+
+#include <atomic>
+#include <utility>
+
+#include "core/parallel.h"
+
+namespace trading
+{
+
+    ThreadPool::ThreadPool(std::size_t threads, std::function<void(std::size_t)> onStart)
+        : onStart_(std::move(onStart))
+    {
+        if (threads == 0)
+        {
+            threads = defaultThreadCount();
+        }
+        threads_.reserve(threads);
+        try
+        {
+            for (std::size_t w = 0; w < threads; ++w)
+            {
+                threads_.emplace_back(&ThreadPool::workerLoop, this, w);
+            }
+        }
+        catch (...)
+        {
+            stop();
+            throw;
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        stop();
+    }
+
+    void ThreadPool::stop() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto &th : threads_)
+        {
+            th.join();
+        }
+        threads_.clear();
+    }
+
+    void ThreadPool::workerLoop(std::size_t worker)
+    {
+        if (onStart_)
+        {
+            onStart_(worker);
+        }
+
+        std::uint64_t seen = 0;
+        for (;;)
+        {
+            const std::function<void(std::size_t)> *job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+                if (stopping_)
+                {
+                    return;
+                }
+                seen = generation_;
+                job = job_;
+            }
+
+            std::exception_ptr error;
+            try
+            {
+                (*job)(worker);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (error && !error_)
+            {
+                error_ = error;
+            }
+            if (--pending_ == 0)
+            {
+                finished_.notify_one();
+            }
+        }
+    }
+
+    void ThreadPool::runOnEach(const std::function<void(std::size_t)> &job)
+    {
+        std::lock_guard<std::mutex> run(runMutex_);
+
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            job_ = &job;
+            pending_ = threads_.size();
+            ++generation_;
+            wake_.notify_all();
+            finished_.wait(lock, [&] { return pending_ == 0; });
+            job_ = nullptr;
+            error = std::exchange(error_, nullptr);
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)> &fn)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> failed{false};
+        runOnEach([&](std::size_t)
+        {
+            while (!failed.load(std::memory_order_relaxed))
+            {
+                const std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= count)
+                {
+                    return;
+                }
+                try
+                {
+                    fn(i);
+                }
+                catch (...)
+                {
+                    failed.store(true, std::memory_order_relaxed);
+                    throw;
+                }
+            }
+        });
+    }
+
+} // namespace trading
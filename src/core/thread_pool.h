@@ -0,0 +1,61 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace trading
+{
+
+    // Fixed set of long-lived worker threads. Each run hands one job to every
+    // worker and waits for all of them, so repeated short parallel passes (a
+    // per-bar matrix update, a scheduler run) reuse the same threads instead
+    // of creating and joining new ones.
+    //
+    // Runs from different threads are serialised. A job must not start another
+    // run on the pool that is executing it.
+    class ThreadPool
+    {
+    public:
+        // threads: 0 = defaultThreadCount(). onStart(worker) runs once on each
+        // new thread before its first job, e.g. to pin it to a CPU; it must not throw.
+        explicit ThreadPool(std::size_t threads = 0, std::function<void(std::size_t)> onStart = {});
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        std::size_t threadCount() const noexcept { return threads_.size(); }
+
+        // Run job(worker) once on every worker and wait. The first exception
+        // thrown by a job is rethrown here after all workers have finished.
+        void runOnEach(const std::function<void(std::size_t)> &job);
+
+        // fn(i) for every i in [0, count), handed out one index at a time as in
+        // parallelFor(). The first exception stops further indices and is rethrown.
+        void parallelFor(std::size_t count, const std::function<void(std::size_t)> &fn);
+
+    private:
+        void workerLoop(std::size_t worker);
+        void stop() noexcept;
+
+        std::function<void(std::size_t)> onStart_;
+        std::vector<std::thread> threads_;
+
+        std::mutex runMutex_; // held for the whole of one run
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable finished_;
+        const std::function<void(std::size_t)> *job_ = nullptr;
+        std::uint64_t generation_ = 0; // bumped once per run
+        std::size_t pending_ = 0;      // workers still inside the current job
+        bool stopping_ = false;
+        std::exception_ptr error_;
+    };
+
+} // namespace trading
@@ -0,0 +1,90 @@
+#include "core/timestamp.h"
+
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+
+namespace trading
+{
+    namespace
+    {
+        constexpr EpochSeconds kSecondsPerDay = 86400;
+
+        int parseDigits(const std::string &s, std::size_t pos, std::size_t len)
+        {
+            int value = 0;
+            for (std::size_t i = pos; i < pos + len; ++i)
+            {
+                const char c = s[i];
+                if (c < '0' || c > '9')
+                {
+                    throw std::invalid_argument("expected digits in timestamp: " + s);
+                }
+                value = value * 10 + (c - '0');
+            }
+            return value;
+        }
+
+        EpochSeconds floorDiv(EpochSeconds a, EpochSeconds b)
+        {
+            const EpochSeconds q = a / b;
+            return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+        }
+    } // namespace
+
+    EpochSeconds toEpochSeconds(const std::string &date, const std::string &time)
+    {
+        if (date.size() != 8)
+        {
+            throw std::invalid_argument("expected date in YYYYMMDD format");
+        }
+
+        const std::chrono::year_month_day ymd{
+            std::chrono::year{parseDigits(date, 0, 4)},
+            std::chrono::month{static_cast<unsigned int>(parseDigits(date, 4, 2))},
+            std::chrono::day{static_cast<unsigned int>(parseDigits(date, 6, 2))}};
+        if (!ymd.ok())
+        {
+            throw std::invalid_argument("invalid calendar date: " + date);
+        }
+
+        EpochSeconds seconds = 0;
+        if (!time.empty())
+        {
+            if (time.size() != 6)
+            {
+                throw std::invalid_argument("expected time in HHMMSS format");
+            }
+            seconds = parseDigits(time, 0, 2) * 3600 + parseDigits(time, 2, 2) * 60 + parseDigits(time, 4, 2);
+        }
+
+        const std::chrono::sys_days days{ymd};
+        return static_cast<EpochSeconds>(days.time_since_epoch().count()) * kSecondsPerDay + seconds;
+    }
+
+    std::string formatDate(EpochSeconds timestamp)
+    {
+        const std::chrono::sys_days days{std::chrono::days{floorDiv(timestamp, kSecondsPerDay)}};
+        const std::chrono::year_month_day ymd{days};
+
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%04d%02u%02u",
+                      static_cast<int>(ymd.year()),
+                      static_cast<unsigned int>(ymd.month()),
+                      static_cast<unsigned int>(ymd.day()));
+        return buf;
+    }
+
+    std::string formatTime(EpochSeconds timestamp)
+    {
+        const EpochSeconds secondOfDay = timestamp - floorDiv(timestamp, kSecondsPerDay) * kSecondsPerDay;
+
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%02d%02d%02d",
+                      static_cast<int>(secondOfDay / 3600),
+                      static_cast<int>((secondOfDay / 60) % 60),
+                      static_cast<int>(secondOfDay % 60));
+        return buf;
+    }
+
+} // namespace trading
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace trading
+{
+
+    // Seconds since the Unix epoch (UTC, no leap seconds).
+    using EpochSeconds = std::int64_t;
+
+    // Convert "YYYYMMDD" and "HHMMSS" strings to seconds since epoch.
+    // An empty time is treated as midnight.
+    EpochSeconds toEpochSeconds(const std::string &date, const std::string &time);
+
+    // Format the date part of a timestamp as "YYYYMMDD".
+    std::string formatDate(EpochSeconds timestamp);
+
+    // Format the time-of-day part of a timestamp as "HHMMSS".
+    std::string formatTime(EpochSeconds timestamp);
+
+} // namespace trading
@@ -0,0 +1,214 @@
+#include "core/topology.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace trading
+{
+    namespace
+    {
+        int parseCpu(const std::string &list, std::size_t begin, std::size_t end)
+        {
+            if (begin == end)
+            {
+                throw std::invalid_argument("empty entry in CPU list: " + list);
+            }
+            int value = 0;
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const char c = list[i];
+                if (c < '0' || c > '9')
+                {
+                    throw std::invalid_argument("bad CPU list: " + list);
+                }
+                value = value * 10 + (c - '0');
+            }
+            return value;
+        }
+
+        // CPUs the process is allowed to run on.
+        std::vector<int> allowedCpus()
+        {
+            std::vector<int> cpus;
+#ifdef __linux__
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (sched_getaffinity(0, sizeof(set), &set) == 0)
+            {
+                for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                {
+                    if (CPU_ISSET(cpu, &set))
+                    {
+                        cpus.push_back(cpu);
+                    }
+                }
+            }
+#endif
+            if (cpus.empty())
+            {
+                const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+                for (unsigned cpu = 0; cpu < hw; ++cpu)
+                {
+                    cpus.push_back(static_cast<int>(cpu));
+                }
+            }
+            return cpus;
+        }
+    } // namespace
+
+    std::size_t CpuTopology::cpuCount() const noexcept
+    {
+        std::size_t count = 0;
+        for (const NumaNode &node : nodes)
+        {
+            count += node.cpus.size();
+        }
+        return count;
+    }
+
+    CpuTopology CpuTopology::detect()
+    {
+        const std::vector<int> allowed = allowedCpus();
+
+        CpuTopology topology;
+        try
+        {
+            topology = fromSysfs("/sys/devices/system/node");
+        }
+        catch (const std::exception &)
+        {
+            topology.nodes.clear();
+        }
+
+        for (NumaNode &node : topology.nodes)
+        {
+            std::erase_if(node.cpus, [&](int cpu)
+                          { return !std::binary_search(allowed.begin(), allowed.end(), cpu); });
+        }
+        std::erase_if(topology.nodes, [](const NumaNode &node)
+                      { return node.cpus.empty(); });
+
+        if (topology.nodes.empty())
+        {
+            topology.nodes.push_back(NumaNode{0, allowed});
+        }
+        return topology;
+    }
+
+    CpuTopology CpuTopology::fromSysfs(const std::filesystem::path &root)
+    {
+        CpuTopology topology;
+        std::error_code ec;
+        if (!std::filesystem::is_directory(root, ec))
+        {
+            return topology;
+        }
+
+        for (const auto &entry : std::filesystem::directory_iterator(root, ec))
+        {
+            const std::string name = entry.path().filename().string();
+            if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+                !std::all_of(name.begin() + 4, name.end(), [](char c)
+                             { return c >= '0' && c <= '9'; }))
+            {
+                continue;
+            }
+
+            std::ifstream in(entry.path() / "cpulist");
+            std::string list;
+            if (!in || !std::getline(in, list))
+            {
+                continue;
+            }
+
+            NumaNode node;
+            node.id = std::stoi(name.substr(4));
+            node.cpus = parseCpuList(list);
+            if (!node.cpus.empty())
+            {
+                topology.nodes.push_back(std::move(node));
+            }
+        }
+
+        std::sort(topology.nodes.begin(), topology.nodes.end(), [](const NumaNode &a, const NumaNode &b)
+                  { return a.id < b.id; });
+        return topology;
+    }
+
+    CpuTopology CpuTopology::singleNode(std::size_t cpus)
+    {
+        NumaNode node;
+        for (std::size_t cpu = 0; cpu < std::max<std::size_t>(cpus, 1); ++cpu)
+        {
+            node.cpus.push_back(static_cast<int>(cpu));
+        }
+        CpuTopology topology;
+        topology.nodes.push_back(std::move(node));
+        return topology;
+    }
+
+    std::vector<int> parseCpuList(const std::string &list)
+    {
+        std::vector<int> cpus;
+        std::size_t end = list.find_last_not_of(" \t\r\n");
+        if (end == std::string::npos)
+        {
+            return cpus;
+        }
+        ++end;
+
+        std::size_t pos = 0;
+        while (pos < end)
+        {
+            const std::size_t comma = std::min(list.find(',', pos), end);
+            const std::size_t dash = list.find('-', pos);
+            if (dash < comma)
+            {
+                const int first = parseCpu(list, pos, dash);
+                const int last = parseCpu(list, dash + 1, comma);
+                if (last < first)
+                {
+                    throw std::invalid_argument("bad CPU range: " + list);
+                }
+                for (int cpu = first; cpu <= last; ++cpu)
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+            else
+            {
+                cpus.push_back(parseCpu(list, pos, comma));
+            }
+            pos = comma + 1;
+        }
+
+        std::sort(cpus.begin(), cpus.end());
+        cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+        return cpus;
+    }
+
+    bool pinCurrentThread(int cpu)
+    {
+#ifdef __linux__
+        if (cpu < 0 || cpu >= CPU_SETSIZE)
+        {
+            return false;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)cpu;
+        return false;
+#endif
+    }
+
+} // namespace trading
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace trading
+{
+
+    // One NUMA node and the logical CPUs attached to it.
+    struct NumaNode
+    {
+        int id = 0;
+        std::vector<int> cpus;
+    };
+
+    // NUMA layout of the machine as seen by this process.
+    struct CpuTopology
+    {
+        std::vector<NumaNode> nodes;
+
+        std::size_t cpuCount() const noexcept;
+
+        // Nodes from /sys/devices/system/node restricted to the CPUs this
+        // process may run on. Falls back to a single node holding every allowed
+        // CPU when sysfs has no node information (non-NUMA kernels, containers).
+        static CpuTopology detect();
+
+        // Nodes listed under root (node<N>/cpulist), without affinity filtering.
+        // Returns no nodes if root does not exist.
+        static CpuTopology fromSysfs(const std::filesystem::path &root);
+
+        // A single node with CPUs 0..cpus-1.
+        static CpuTopology singleNode(std::size_t cpus);
+    };
+
+    // Parse a kernel CPU list such as "0-3,8,10-11". Throws std::invalid_argument.
+    std::vector<int> parseCpuList(const std::string &list);
+
+    // Pin the calling thread to one CPU. Returns false if the OS refuses
+    // (unknown CPU, restricted cpuset) or pinning is unsupported.
+    bool pinCurrentThread(int cpu);
+
+} // namespace trading
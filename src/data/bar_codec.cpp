@@ -0,0 +1,501 @@
+#include "data/bar_codec.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "core/instrumentation.h"
+
+namespace trading
+{
+    namespace
+    {
+        static_assert(std::endian::native == std::endian::little,
+                      "bar codec assumes a little-endian target");
+
+        // Extra zero bytes after each payload so the decoder can always load
+        // a full 64-bit word (two for widths above 56 bits).
+        constexpr std::size_t kPadding = 16;
+
+        constexpr int kMaxDecimals = 6;
+        constexpr double kPow10[kMaxDecimals + 1] = {1.0, 10.0, 100.0, 1e3, 1e4, 1e5, 1e6};
+
+        // Largest magnitude a scaled value may have and still be exact in a double.
+        constexpr double kMaxExactInteger = 9007199254740992.0; // 2^53
+
+        unsigned bitsNeeded(std::uint64_t range)
+        {
+            return static_cast<unsigned>(std::bit_width(range));
+        }
+
+        std::uint64_t load64(const std::uint8_t *p)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            return word;
+        }
+
+        std::uint64_t zigzag(std::int64_t v)
+        {
+            return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+        }
+
+        std::int64_t unzigzag(std::uint64_t v)
+        {
+            return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+        }
+
+        std::vector<std::uint8_t> packBits(const std::vector<std::uint64_t> &values, unsigned width)
+        {
+            if (width == 0)
+            {
+                return {};
+            }
+
+            std::vector<std::uint8_t> bytes((values.size() * width + 7) / 8 + kPadding, 0);
+            std::size_t bit = 0;
+            for (std::uint64_t v : values)
+            {
+                // Write the value LSB-first, one byte at a time.
+                unsigned remaining = width;
+                while (remaining > 0)
+                {
+                    const std::size_t byte = bit >> 3;
+                    const unsigned shift = static_cast<unsigned>(bit & 7);
+                    const unsigned take = std::min(remaining, 8u - shift);
+                    bytes[byte] |= static_cast<std::uint8_t>((v & ((1u << take) - 1)) << shift);
+                    v >>= take;
+                    bit += take;
+                    remaining -= take;
+                }
+            }
+            return bytes;
+        }
+
+        // Invoke sink(i, packed_i) for each of the n packed values.
+        // Widths up to 56 bits need a single unaligned load per value; the loop
+        // has no data-dependent branches so the compiler can vectorise it.
+        template <typename Sink>
+        void unpackBits(const PackedColumn &column, std::size_t n, Sink &&sink)
+        {
+            const unsigned width = column.bitWidth;
+            if (width == 0)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    sink(i, std::uint64_t{0});
+                }
+                return;
+            }
+
+            const std::uint8_t *bytes = column.bytes.data();
+            const std::uint64_t mask = (width == 64) ? ~std::uint64_t{0} : ((std::uint64_t{1} << width) - 1);
+
+            if (width <= 56)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const std::size_t bit = i * width;
+                    sink(i, (load64(bytes + (bit >> 3)) >> (bit & 7)) & mask);
+                }
+                return;
+            }
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const std::size_t bit = i * width;
+                const unsigned shift = static_cast<unsigned>(bit & 7);
+                const std::uint64_t lo = load64(bytes + (bit >> 3));
+                const std::uint64_t hi = load64(bytes + (bit >> 3) + 8);
+                const std::uint64_t v = (shift == 0) ? lo : ((lo >> shift) | (hi << (64 - shift)));
+                sink(i, v & mask);
+            }
+        }
+
+        PackedColumn packUnsigned(const std::vector<std::uint64_t> &values)
+        {
+            PackedColumn column;
+            column.encoding = PackedColumn::Encoding::Integer;
+            if (values.empty())
+            {
+                return column;
+            }
+
+            const auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end());
+            const std::uint64_t reference = *minIt;
+
+            std::vector<std::uint64_t> offsets(values.size());
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                offsets[i] = values[i] - reference;
+            }
+
+            column.reference = static_cast<std::int64_t>(reference);
+            column.bitWidth = static_cast<std::uint8_t>(bitsNeeded(*maxIt - reference));
+            column.bytes = packBits(offsets, column.bitWidth);
+            return column;
+        }
+
+        // Find the smallest decimal scale at which every value is an exact integer.
+        bool scaleToIntegers(const std::vector<double> &values, int decimals, std::vector<std::int64_t> &scaled)
+        {
+            const double scale = kPow10[decimals];
+            scaled.resize(values.size());
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                const double v = values[i];
+                const double s = v * scale;
+                if (!std::isfinite(s) || std::fabs(s) >= kMaxExactInteger)
+                {
+                    return false;
+                }
+                const double rounded = std::nearbyint(s);
+                if (rounded / scale != v)
+                {
+                    return false;
+                }
+                scaled[i] = static_cast<std::int64_t>(rounded);
+            }
+            return true;
+        }
+
+        PackedColumn packDoubles(const std::vector<double> &values)
+        {
+            std::vector<std::int64_t> scaled;
+            for (int decimals = 0; decimals <= kMaxDecimals; ++decimals)
+            {
+                if (!scaleToIntegers(values, decimals, scaled))
+                {
+                    continue;
+                }
+
+                PackedColumn column;
+                column.encoding = PackedColumn::Encoding::Scaled;
+                column.decimals = static_cast<std::uint8_t>(decimals);
+                if (scaled.empty())
+                {
+                    return column;
+                }
+
+                const auto [minIt, maxIt] = std::minmax_element(scaled.begin(), scaled.end());
+                const std::int64_t reference = *minIt;
+                std::vector<std::uint64_t> offsets(scaled.size());
+                for (std::size_t i = 0; i < scaled.size(); ++i)
+                {
+                    offsets[i] = static_cast<std::uint64_t>(scaled[i] - reference);
+                }
+
+                column.reference = reference;
+                column.bitWidth = static_cast<std::uint8_t>(bitsNeeded(static_cast<std::uint64_t>(*maxIt - reference)));
+                column.bytes = packBits(offsets, column.bitWidth);
+                return column;
+            }
+
+            // No exact decimal representation: keep the raw bit patterns.
+            std::vector<std::uint64_t> raw(values.size());
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                raw[i] = std::bit_cast<std::uint64_t>(values[i]);
+            }
+
+            PackedColumn column;
+            column.encoding = PackedColumn::Encoding::Raw;
+            column.bitWidth = 64;
+            column.bytes = packBits(raw, 64);
+            return column;
+        }
+
+        void unpackDoubles(const PackedColumn &column, std::size_t n, double *out)
+        {
+            switch (column.encoding)
+            {
+            case PackedColumn::Encoding::Scaled:
+            {
+                const std::int64_t reference = column.reference;
+                if (column.decimals == 0)
+                {
+                    unpackBits(column, n, [&](std::size_t i, std::uint64_t v)
+                               { out[i] = static_cast<double>(reference + static_cast<std::int64_t>(v)); });
+                }
+                else
+                {
+                    const double scale = kPow10[column.decimals];
+                    unpackBits(column, n, [&](std::size_t i, std::uint64_t v)
+                               { out[i] = static_cast<double>(reference + static_cast<std::int64_t>(v)) / scale; });
+                }
+                return;
+            }
+            case PackedColumn::Encoding::Raw:
+                unpackBits(column, n, [&](std::size_t i, std::uint64_t v)
+                           { out[i] = std::bit_cast<double>(v); });
+                return;
+            case PackedColumn::Encoding::Integer:
+            {
+                const auto reference = static_cast<std::uint64_t>(column.reference);
+                unpackBits(column, n, [&](std::size_t i, std::uint64_t v)
+                           { out[i] = static_cast<double>(reference + v); });
+                return;
+            }
+            }
+        }
+
+        template <typename T>
+        void unpackIntegers(const PackedColumn &column, std::size_t n, T *out)
+        {
+            const auto reference = static_cast<std::uint64_t>(column.reference);
+            unpackBits(column, n, [&](std::size_t i, std::uint64_t v)
+                       { out[i] = static_cast<T>(reference + v); });
+        }
+
+        std::uint64_t internString(const std::string &s,
+                                   std::unordered_map<std::string, std::uint64_t> &index,
+                                   std::vector<std::string> &dictionary)
+        {
+            const auto [it, inserted] = index.try_emplace(s, dictionary.size());
+            if (inserted)
+            {
+                dictionary.push_back(s);
+            }
+            return it->second;
+        }
+
+        std::size_t columnBytes(const PackedColumn &column)
+        {
+            return column.bytes.size() + sizeof(column.reference) + 3;
+        }
+    } // namespace
+
+    CompressedBarSeries CompressedBarSeries::encode(const std::vector<Bar> &bars, std::size_t blockSize)
+    {
+        TRADING_TRACE_SCOPE("CompressedBarSeries::encode");
+
+        if (blockSize == 0)
+        {
+            throw std::invalid_argument("blockSize must be > 0");
+        }
+
+        CompressedBarSeries series;
+        series.blockSize_ = blockSize;
+        series.size_ = bars.size();
+        series.blocks_.reserve((bars.size() + blockSize - 1) / blockSize);
+
+        std::unordered_map<std::string, std::uint64_t> symbolIndex;
+        std::unordered_map<std::string, std::uint64_t> periodIndex;
+
+        std::vector<EpochSeconds> timestamps;
+        std::vector<std::uint64_t> dods;
+        std::vector<double> open, high, low, close, volume;
+        std::vector<std::uint64_t> openInterest, symbolIds, periodIds;
+
+        for (std::size_t begin = 0; begin < bars.size(); begin += blockSize)
+        {
+            const std::size_t n = std::min(blockSize, bars.size() - begin);
+
+            timestamps.resize(n);
+            open.resize(n);
+            high.resize(n);
+            low.resize(n);
+            close.resize(n);
+            volume.resize(n);
+            openInterest.resize(n);
+            symbolIds.resize(n);
+            periodIds.resize(n);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const Bar &bar = bars[begin + i];
+                timestamps[i] = toEpochSeconds(bar.date, bar.time);
+                open[i] = bar.open;
+                high[i] = bar.high;
+                low[i] = bar.low;
+                close[i] = bar.close;
+                volume[i] = bar.volume;
+                openInterest[i] = bar.openInterest;
+                symbolIds[i] = internString(bar.symbol, symbolIndex, series.symbols_);
+                periodIds[i] = internString(bar.period, periodIndex, series.periods_);
+            }
+
+            CompressedBarBlock block;
+            block.count = n;
+            block.firstTimestamp = timestamps[0];
+            block.firstDelta = (n > 1) ? timestamps[1] - timestamps[0] : 0;
+
+            dods.clear();
+            for (std::size_t i = 2; i < n; ++i)
+            {
+                const std::int64_t delta = timestamps[i] - timestamps[i - 1];
+                const std::int64_t prevDelta = timestamps[i - 1] - timestamps[i - 2];
+                dods.push_back(zigzag(delta - prevDelta));
+            }
+
+            block.timestampDeltas = packUnsigned(dods);
+            block.open = packDoubles(open);
+            block.high = packDoubles(high);
+            block.low = packDoubles(low);
+            block.close = packDoubles(close);
+            block.volume = packDoubles(volume);
+            block.openInterest = packUnsigned(openInterest);
+            block.symbolIds = packUnsigned(symbolIds);
+            block.periodIds = packUnsigned(periodIds);
+
+            series.blocks_.push_back(std::move(block));
+        }
+
+        // Map the dictionaries onto the process-wide tables once, not per block.
+        series.symbolIds_.reserve(series.symbols_.size());
+        for (const auto &symbol : series.symbols_)
+        {
+            series.symbolIds_.push_back(symbolTable().intern(symbol));
+        }
+        series.periodIds_.reserve(series.periods_.size());
+        for (const auto &period : series.periods_)
+        {
+            series.periodIds_.push_back(periodTable().intern(period));
+        }
+
+        return series;
+    }
+
+    const CompressedBarBlock &CompressedBarSeries::checkedBlock(std::size_t block) const
+    {
+        if (block >= blocks_.size())
+        {
+            throw std::out_of_range("block index out of range");
+        }
+        return blocks_[block];
+    }
+
+    std::size_t CompressedBarSeries::blockSize(std::size_t block) const
+    {
+        return checkedBlock(block).count;
+    }
+
+    std::size_t CompressedBarSeries::blockOffset(std::size_t block) const
+    {
+        checkedBlock(block);
+        return block * blockSize_;
+    }
+
+    std::size_t CompressedBarSeries::compressedBytes() const noexcept
+    {
+        std::size_t total = sizeof(*this);
+        for (const auto &s : symbols_)
+        {
+            total += s.size() + 1;
+        }
+        for (const auto &p : periods_)
+        {
+            total += p.size() + 1;
+        }
+        total += (symbolIds_.size() + periodIds_.size()) * sizeof(SymbolId);
+        for (const auto &b : blocks_)
+        {
+            total += sizeof(b.count) + sizeof(b.firstTimestamp) + sizeof(b.firstDelta);
+            total += columnBytes(b.timestampDeltas) + columnBytes(b.open) + columnBytes(b.high) +
+                     columnBytes(b.low) + columnBytes(b.close) + columnBytes(b.volume) +
+                     columnBytes(b.openInterest) + columnBytes(b.symbolIds) + columnBytes(b.periodIds);
+        }
+        return total;
+    }
+
+    void CompressedBarSeries::decodeField(std::size_t block, BarField field, double *out) const
+    {
+        const CompressedBarBlock &b = checkedBlock(block);
+        switch (field)
+        {
+        case BarField::Open:
+            unpackDoubles(b.open, b.count, out);
+            break;
+        case BarField::High:
+            unpackDoubles(b.high, b.count, out);
+            break;
+        case BarField::Low:
+            unpackDoubles(b.low, b.count, out);
+            break;
+        case BarField::Close:
+            unpackDoubles(b.close, b.count, out);
+            break;
+        case BarField::Volume:
+            unpackDoubles(b.volume, b.count, out);
+            break;
+        }
+    }
+
+    void CompressedBarSeries::decodeTimestamps(std::size_t block, EpochSeconds *out) const
+    {
+        const CompressedBarBlock &b = checkedBlock(block);
+        if (b.count == 0)
+        {
+            return;
+        }
+
+        out[0] = b.firstTimestamp;
+        if (b.count == 1)
+        {
+            return;
+        }
+        out[1] = b.firstTimestamp + b.firstDelta;
+
+        // Unpack the delta-of-deltas in place, then integrate twice.
+        std::int64_t *dods = out + 2;
+        const auto reference = static_cast<std::uint64_t>(b.timestampDeltas.reference);
+        unpackBits(b.timestampDeltas, b.count - 2, [&](std::size_t i, std::uint64_t v)
+                   { dods[i] = unzigzag(reference + v); });
+
+        std::int64_t delta = b.firstDelta;
+        for (std::size_t i = 2; i < b.count; ++i)
+        {
+            delta += out[i];
+            out[i] = out[i - 1] + delta;
+        }
+    }
+
+    void CompressedBarSeries::decodeBlock(std::size_t block, BarColumns &out, std::size_t offset) const
+    {
+        const CompressedBarBlock &b = checkedBlock(block);
+        if (out.size() < offset + b.count)
+        {
+            throw std::invalid_argument("output columns too small for block");
+        }
+
+        decodeTimestamps(block, out.timestamps.data() + offset);
+        unpackDoubles(b.open, b.count, out.open.data() + offset);
+        unpackDoubles(b.high, b.count, out.high.data() + offset);
+        unpackDoubles(b.low, b.count, out.low.data() + offset);
+        unpackDoubles(b.close, b.count, out.close.data() + offset);
+        unpackDoubles(b.volume, b.count, out.volume.data() + offset);
+        unpackIntegers(b.openInterest, b.count, out.openInterest.data() + offset);
+
+        SymbolId *symbolOut = out.symbolIds.data() + offset;
+        SymbolId *periodOut = out.periodIds.data() + offset;
+        unpackIntegers(b.symbolIds, b.count, symbolOut);
+        unpackIntegers(b.periodIds, b.count, periodOut);
+        for (std::size_t i = 0; i < b.count; ++i)
+        {
+            symbolOut[i] = symbolIds_[symbolOut[i]];
+            periodOut[i] = periodIds_[periodOut[i]];
+        }
+    }
+
+    BarColumns CompressedBarSeries::decodeColumns() const
+    {
+        TRADING_TRACE_SCOPE("CompressedBarSeries::decodeColumns");
+
+        BarColumns columns;
+        columns.resize(size_);
+        for (std::size_t block = 0; block < blocks_.size(); ++block)
+        {
+            decodeBlock(block, columns, block * blockSize_);
+        }
+        return columns;
+    }
+
+    std::vector<Bar> CompressedBarSeries::decodeBars() const
+    {
+        return toBars(decodeColumns());
+    }
+
+} // namespace trading
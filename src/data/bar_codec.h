@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/bar.h"
+#include "core/bar_columns.h"
+
+namespace trading
+{
+
+    // Numeric bar fields that can be decoded straight into a double array.
+    enum class BarField
+    {
+        Open,
+        High,
+        Low,
+        Close,
+        Volume
+    };
+
+    // One bit-packed column of a compressed block.
+    // Every entry is stored as (value - reference) in bitWidth bits.
+    struct PackedColumn
+    {
+        enum class Encoding : std::uint8_t
+        {
+            Integer, // unsigned integers, frame-of-reference
+            Scaled,  // doubles stored as integers scaled by 10^decimals
+            Raw      // IEEE-754 bit patterns, used when no exact decimal scale exists
+        };
+
+        Encoding encoding = Encoding::Integer;
+        std::uint8_t bitWidth = 0;
+        std::uint8_t decimals = 0;
+        std::int64_t reference = 0;
+        std::vector<std::uint8_t> bytes;
+    };
+
+    // A run of consecutive bars encoded column by column.
+    struct CompressedBarBlock
+    {
+        std::size_t count = 0;
+        EpochSeconds firstTimestamp = 0;
+        std::int64_t firstDelta = 0;
+        PackedColumn timestampDeltas; // zig-zag delta-of-delta for entries [2, count)
+        PackedColumn open;
+        PackedColumn high;
+        PackedColumn low;
+        PackedColumn close;
+        PackedColumn volume;
+        PackedColumn openInterest;
+        PackedColumn symbolIds; // indices into CompressedBarSeries::symbols()
+        PackedColumn periodIds; // indices into CompressedBarSeries::periods()
+    };
+
+    // Block-compressed, column-oriented bar history.
+    //
+    // Timestamps are delta-of-delta encoded, prices and volumes are converted to
+    // scaled integers (the smallest power of ten that round-trips exactly) and
+    // frame-of-reference bit-packed, and symbol/period strings go through a
+    // per-series dictionary. Decoding is lossless: decodeBars() reproduces the
+    // input except that an empty time is returned as "000000".
+    class CompressedBarSeries
+    {
+    public:
+        static constexpr std::size_t kDefaultBlockSize = 4096;
+
+        // Encode bars; throws std::invalid_argument on malformed dates/times.
+        static CompressedBarSeries encode(const std::vector<Bar> &bars, std::size_t blockSize = kDefaultBlockSize);
+
+        std::size_t size() const noexcept { return size_; }
+        std::size_t blockCount() const noexcept { return blocks_.size(); }
+
+        // Number of bars in a block and index of its first bar in the series.
+        std::size_t blockSize(std::size_t block) const;
+        std::size_t blockOffset(std::size_t block) const;
+
+        // Approximate in-memory footprint of the encoded data.
+        std::size_t compressedBytes() const noexcept;
+
+        // Decode one field of a block into out[0, blockSize(block)).
+        void decodeField(std::size_t block, BarField field, double *out) const;
+
+        // Decode the timestamps of a block into out[0, blockSize(block)).
+        void decodeTimestamps(std::size_t block, EpochSeconds *out) const;
+
+        // Decode a whole block into columns starting at row offset.
+        // The columns must already hold at least offset + blockSize(block) rows.
+        void decodeBlock(std::size_t block, BarColumns &out, std::size_t offset) const;
+
+        BarColumns decodeColumns() const;
+        std::vector<Bar> decodeBars() const;
+
+        const std::vector<std::string> &symbols() const noexcept { return symbols_; }
+        const std::vector<std::string> &periods() const noexcept { return periods_; }
+
+    private:
+        const CompressedBarBlock &checkedBlock(std::size_t block) const;
+
+        std::size_t blockSize_ = kDefaultBlockSize;
+        std::size_t size_ = 0;
+        std::vector<CompressedBarBlock> blocks_;
+        std::vector<std::string> symbols_;
+        std::vector<std::string> periods_;
+        // symbols_/periods_ interned in symbolTable()/periodTable() once, by encode().
+        std::vector<SymbolId> symbolIds_;
+        std::vector<SymbolId> periodIds_;
+    };
+
+} // namespace trading
@@ -0,0 +1,203 @@
+#include "data/bar_validation.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "core/instrumentation.h"
+
+namespace trading
+{
+    namespace
+    {
+        constexpr const char *kIssueNames[kBarIssueCount] = {
+            "non-positive close",
+            "high below low",
+            "out of order",
+            "duplicate timestamp",
+            "zero volume",
+            "gap before bar",
+            "bad timestamp"};
+
+        constexpr std::uint8_t bit(BarIssue issue)
+        {
+            return static_cast<std::uint8_t>(issue);
+        }
+
+        EpochSeconds medianSpacing(const BarColumns &columns,
+                                   const std::vector<BarIssues> &flags,
+                                   const std::vector<std::uint8_t> &runStart)
+        {
+            std::vector<EpochSeconds> deltas;
+            deltas.reserve(columns.size());
+            for (std::size_t i = 1; i < columns.size(); ++i)
+            {
+                const EpochSeconds d = columns.timestamps[i] - columns.timestamps[i - 1];
+                const bool parsed = !(flags[i] | flags[i - 1]).has(BarIssue::BadTimestamp);
+                if (!runStart[i] && parsed && d > 0)
+                {
+                    deltas.push_back(d);
+                }
+            }
+            if (deltas.empty())
+            {
+                return 0;
+            }
+            auto mid = deltas.begin() + static_cast<std::ptrdiff_t>(deltas.size() / 2);
+            std::nth_element(deltas.begin(), mid, deltas.end());
+            return *mid;
+        }
+
+        // flags must hold any pre-set BadTimestamp bits; runStart marks the
+        // first bar of each symbol run.
+        ValidationReport validateCore(const BarColumns &c,
+                                      std::vector<BarIssues> flags,
+                                      const std::vector<std::uint8_t> &runStart,
+                                      const ValidationOptions &options)
+        {
+            const std::size_t n = c.size();
+
+            ValidationReport report;
+            report.maxGapSeconds = options.maxGapSeconds;
+            if (report.maxGapSeconds <= 0)
+            {
+                const EpochSeconds median = medianSpacing(c, flags, runStart);
+                report.maxGapSeconds = (median > 0) ? 5 * median : std::numeric_limits<EpochSeconds>::max();
+            }
+
+            // Pass 1: value checks, independent per bar.
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const double close = c.close[i];
+                flags[i] |= BarIssues::fromBits(static_cast<std::uint8_t>(
+                    (!(close > 0.0) ? bit(BarIssue::NonPositiveClose) : 0) |
+                    (!(c.high[i] >= c.low[i]) ? bit(BarIssue::HighBelowLow) : 0) |
+                    ((c.volume[i] == 0.0) ? bit(BarIssue::ZeroVolume) : 0)));
+            }
+
+            // Pass 2: ordering against the latest timestamp seen in the run.
+            EpochSeconds latest = 0;
+            bool haveLatest = false;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                if (runStart[i])
+                {
+                    haveLatest = false;
+                }
+                if (flags[i].has(BarIssue::BadTimestamp))
+                {
+                    continue;
+                }
+
+                const EpochSeconds t = c.timestamps[i];
+                if (haveLatest)
+                {
+                    flags[i] |= BarIssues::fromBits(static_cast<std::uint8_t>(
+                        ((t < latest) ? bit(BarIssue::OutOfOrder) : 0) |
+                        ((t == latest) ? bit(BarIssue::DuplicateTimestamp) : 0) |
+                        ((t > latest && t - latest > report.maxGapSeconds) ? bit(BarIssue::GapBefore) : 0)));
+                    latest = std::max(latest, t);
+                }
+                else
+                {
+                    latest = t;
+                    haveLatest = true;
+                }
+            }
+
+            // Pass 3: tallies.
+            for (BarIssues f : flags)
+            {
+                for (std::size_t b = 0; b < kBarIssueCount; ++b)
+                {
+                    report.counts[b] += (f.bits() >> b) & 1u;
+                }
+                report.dropped += (f & options.dropMask).any();
+            }
+
+            report.flags = std::move(flags);
+            return report;
+        }
+    } // namespace
+
+    std::size_t ValidationReport::count(BarIssue issue) const
+    {
+        return counts[static_cast<std::size_t>(std::countr_zero(bit(issue)))];
+    }
+
+    std::string ValidationReport::summary() const
+    {
+        std::ostringstream out;
+        out << flags.size() << " bars, " << dropped << " dropped\n";
+        for (std::size_t b = 0; b < kBarIssueCount; ++b)
+        {
+            if (counts[b] > 0)
+            {
+                out << "  " << kIssueNames[b] << ": " << counts[b] << '\n';
+            }
+        }
+        return out.str();
+    }
+
+    ValidationReport validateColumns(const BarColumns &columns, const ValidationOptions &options)
+    {
+        TRADING_TRACE_SCOPE("validateColumns");
+
+        std::vector<std::uint8_t> runStart(columns.size(), 0);
+        if (!runStart.empty())
+        {
+            runStart[0] = 1;
+        }
+        return validateCore(columns, std::vector<BarIssues>(columns.size()), runStart, options);
+    }
+
+    ValidationReport validateBars(const std::vector<Bar> &bars, const ValidationOptions &options)
+    {
+        TRADING_TRACE_SCOPE("validateBars");
+
+        BarColumns columns;
+        columns.resize(bars.size());
+        std::vector<BarIssues> flags(bars.size());
+        std::vector<std::uint8_t> runStart(bars.size(), 0);
+
+        for (std::size_t i = 0; i < bars.size(); ++i)
+        {
+            const Bar &bar = bars[i];
+            runStart[i] = (i == 0 || bar.symbol != bars[i - 1].symbol);
+            try
+            {
+                columns.timestamps[i] = toEpochSeconds(bar.date, bar.time);
+            }
+            catch (const std::invalid_argument &)
+            {
+                flags[i] = BarIssue::BadTimestamp;
+            }
+            columns.open[i] = bar.open;
+            columns.high[i] = bar.high;
+            columns.low[i] = bar.low;
+            columns.close[i] = bar.close;
+            columns.volume[i] = bar.volume;
+            columns.openInterest[i] = bar.openInterest;
+        }
+
+        return validateCore(columns, std::move(flags), runStart, options);
+    }
+
+    CleanedBars cleanBars(const std::vector<Bar> &bars, const ValidationOptions &options)
+    {
+        CleanedBars cleaned;
+        cleaned.report = validateBars(bars, options);
+        cleaned.bars.reserve(bars.size() - cleaned.report.dropped);
+        for (std::size_t i = 0; i < bars.size(); ++i)
+        {
+            if (!(cleaned.report.flags[i] & options.dropMask).any())
+            {
+                cleaned.bars.push_back(bars[i]);
+            }
+        }
+        return cleaned;
+    }
+
+} // namespace trading
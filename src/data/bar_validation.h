@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/bar.h"
+#include "core/bar_columns.h"
+
+namespace trading
+{
+
+    // Issues validation can find in a bar; each is one bit of a BarIssues set.
+    enum class BarIssue : std::uint8_t
+    {
+        NonPositiveClose = 1u << 0,   // close <= 0 or NaN
+        HighBelowLow = 1u << 1,       // high < low, or either is NaN
+        OutOfOrder = 1u << 2,         // earlier than a previous bar of the same symbol
+        DuplicateTimestamp = 1u << 3, // same timestamp as the previous bar
+        ZeroVolume = 1u << 4,
+        GapBefore = 1u << 5,          // spacing to the previous bar exceeds maxGapSeconds
+        BadTimestamp = 1u << 6        // date/time could not be parsed
+    };
+
+    constexpr std::size_t kBarIssueCount = 7;
+
+    // Set of BarIssue flags stored in one byte.
+    class BarIssues
+    {
+    public:
+        constexpr BarIssues() noexcept = default;
+        constexpr BarIssues(BarIssue issue) noexcept : bits_(static_cast<std::uint8_t>(issue)) {}
+
+        static constexpr BarIssues fromBits(std::uint8_t bits) noexcept
+        {
+            BarIssues issues;
+            issues.bits_ = bits;
+            return issues;
+        }
+
+        static constexpr BarIssues all() noexcept { return fromBits((1u << kBarIssueCount) - 1); }
+
+        constexpr std::uint8_t bits() const noexcept { return bits_; }
+        constexpr bool any() const noexcept { return bits_ != 0; }
+        constexpr bool has(BarIssue issue) const noexcept { return (bits_ & static_cast<std::uint8_t>(issue)) != 0; }
+
+        constexpr BarIssues operator|(BarIssues other) const noexcept { return fromBits(bits_ | other.bits_); }
+        constexpr BarIssues operator&(BarIssues other) const noexcept { return fromBits(bits_ & other.bits_); }
+        constexpr BarIssues &operator|=(BarIssues other) noexcept
+        {
+            bits_ |= other.bits_;
+            return *this;
+        }
+        constexpr bool operator==(const BarIssues &) const noexcept = default;
+
+    private:
+        std::uint8_t bits_ = 0;
+    };
+
+    constexpr BarIssues operator|(BarIssue a, BarIssue b) noexcept
+    {
+        return BarIssues(a) | BarIssues(b);
+    }
+
+    struct ValidationOptions
+    {
+        // Spacing above which GapBefore is set. 0 = five times the median spacing.
+        EpochSeconds maxGapSeconds = 0;
+
+        // Issues that make cleanBars() drop a bar. Zero volume and gaps are
+        // reported but kept by default.
+        BarIssues dropMask = BarIssue::NonPositiveClose | BarIssue::HighBelowLow | BarIssue::OutOfOrder |
+                             BarIssue::DuplicateTimestamp | BarIssue::BadTimestamp;
+    };
+
+    struct ValidationReport
+    {
+        std::vector<BarIssues> flags;              // issues of each input bar
+        std::array<std::size_t, kBarIssueCount> counts{}; // bars with each issue, by bit index
+        std::size_t dropped = 0;                   // bars matching dropMask
+        EpochSeconds maxGapSeconds = 0;            // threshold that was applied
+
+        std::size_t count(BarIssue issue) const;
+
+        // One line per issue with a non-zero count.
+        std::string summary() const;
+    };
+
+    // Validate a column series of one symbol. All checks are flat passes over
+    // the columns with no early exit.
+    ValidationReport validateColumns(const BarColumns &columns, const ValidationOptions &options = {});
+
+    // Validate bars. Symbols are expected in contiguous runs (a single-symbol
+    // file or a file grouped by symbol); ordering checks restart at each run.
+    ValidationReport validateBars(const std::vector<Bar> &bars, const ValidationOptions &options = {});
+
+    struct CleanedBars
+    {
+        std::vector<Bar> bars; // input bars without the ones matching dropMask
+        ValidationReport report;
+    };
+
+    // Validate once at load time and drop bad bars. The result can be fed to the
+    // metric kernels with InputCheck::Unchecked.
+    CleanedBars cleanBars(const std::vector<Bar> &bars, const ValidationOptions &options = {});
+
+} // namespace trading
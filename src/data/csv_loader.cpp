@@ -2,6 +2,7 @@
 
 #include <stdexcept>
 
+#include "core/instrumentation.h"
 #include "csv.h"
 
 namespace trading
@@ -9,6 +10,8 @@ namespace trading
 
     std::vector<Bar> loadBarsFromCsv(const std::filesystem::path &csvPath)
     {
+        TRADING_TRACE_SCOPE("loadBarsFromCsv");
+
         if (!std::filesystem::exists(csvPath))
         {
             throw std::runtime_error("CSV file not found: " + csvPath.string());
@@ -53,8 +56,83 @@ namespace trading
                 volume,
                 openInterest});
         }
+        TRADING_COUNTER_ADD("csv.rows", bars.size());
 
         return bars;
     }
 
+    BarColumns loadBarColumnsFromCsv(const std::filesystem::path &csvPath)
+    {
+        TRADING_TRACE_SCOPE("loadBarColumnsFromCsv");
+
+        if (!std::filesystem::exists(csvPath))
+        {
+            throw std::runtime_error("CSV file not found: " + csvPath.string());
+        }
+
+        io::CSVReader<10, io::trim_chars<' ', '\t', '<', '>'>, io::no_quote_escape<','>> in(csvPath.string());
+        in.read_header(io::ignore_extra_column,
+                       "TICKER",
+                       "PER",
+                       "DATE",
+                       "TIME",
+                       "OPEN",
+                       "HIGH",
+                       "LOW",
+                       "CLOSE",
+                       "VOL",
+                       "OPENINT");
+
+        BarColumns columns;
+        SymbolTable &symbols = symbolTable();
+        SymbolTable &periods = periodTable();
+
+        // Ticker/period point into the reader's line buffer; only a change of
+        // value goes to the intern tables.
+        char *ticker = nullptr;
+        char *period = nullptr;
+        std::string lastTicker;
+        std::string lastPeriod;
+        SymbolId symbolId = 0;
+        SymbolId periodId = 0;
+        bool first = true;
+
+        std::string date;
+        std::string time;
+        double open{};
+        double high{};
+        double low{};
+        double close{};
+        double volume{};
+        std::uint64_t openInterest{};
+
+        while (in.read_row(ticker, period, date, time, open, high, low, close, volume, openInterest))
+        {
+            if (first || lastTicker != ticker)
+            {
+                lastTicker = ticker;
+                symbolId = symbols.intern(lastTicker);
+            }
+            if (first || lastPeriod != period)
+            {
+                lastPeriod = period;
+                periodId = periods.intern(lastPeriod);
+            }
+            first = false;
+
+            columns.symbolIds.push_back(symbolId);
+            columns.periodIds.push_back(periodId);
+            columns.timestamps.push_back(toEpochSeconds(date, time));
+            columns.open.push_back(open);
+            columns.high.push_back(high);
+            columns.low.push_back(low);
+            columns.close.push_back(close);
+            columns.volume.push_back(volume);
+            columns.openInterest.push_back(openInterest);
+        }
+        TRADING_COUNTER_ADD("csv.rows", columns.size());
+
+        return columns;
+    }
+
 } // namespace trading
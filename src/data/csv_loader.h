@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "core/bar.h"
+#include "core/bar_columns.h"
 
 namespace trading
 {
@@ -11,4 +12,8 @@ namespace trading
     // Load bar data from a CSV file using fast-cpp-csv-parser.
     std::vector<Bar> loadBarsFromCsv(const std::filesystem::path &csvPath);
 
+    // Load the same file straight into columns. Tickers and periods are interned
+    // into symbolTable()/periodTable() rather than copied per row.
+    BarColumns loadBarColumnsFromCsv(const std::filesystem::path &csvPath);
+
 } // namespace trading
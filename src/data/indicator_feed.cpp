@@ -0,0 +1,441 @@
+#include "data/indicator_feed.h"
+
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "core/instrumentation.h"
+
+namespace trading
+{
+    namespace
+    {
+        constexpr std::uint64_t kFeedMagic = 0x44454546444E4954ULL; // "TINDFEED"
+        constexpr std::size_t kPayloadWords = 10;
+
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                      "seqlock words must be lock-free to live in shared memory");
+        static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+        struct alignas(64) FeedHeader
+        {
+            std::atomic<std::uint64_t> magic; // set last by the publisher
+            std::uint32_t version;
+            std::uint32_t capacity;
+            std::atomic<std::uint32_t> symbolCount;
+        };
+
+        // One cache line of sequence + symbol, then the payload words, so a
+        // reader polling the sequence does not share a line with other slots.
+        struct alignas(64) FeedSlot
+        {
+            std::atomic<std::uint64_t> sequence;
+            char symbol[kIndicatorFeedMaxSymbol + 1];
+            std::atomic<std::uint64_t> words[kPayloadWords];
+        };
+
+        std::size_t regionBytes(std::size_t capacity)
+        {
+            return sizeof(FeedHeader) + capacity * sizeof(FeedSlot);
+        }
+
+        FeedHeader *header(void *base)
+        {
+            return static_cast<FeedHeader *>(base);
+        }
+
+        const FeedHeader *header(const void *base)
+        {
+            return static_cast<const FeedHeader *>(base);
+        }
+
+        FeedSlot *slots(void *base)
+        {
+            return reinterpret_cast<FeedSlot *>(static_cast<char *>(base) + sizeof(FeedHeader));
+        }
+
+        const FeedSlot *slots(const void *base)
+        {
+            return reinterpret_cast<const FeedSlot *>(static_cast<const char *>(base) + sizeof(FeedHeader));
+        }
+
+        // Spin-wait hint while a write is in progress.
+        inline void cpuRelax() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        }
+
+        std::runtime_error systemError(const std::string &what, const std::string &name)
+        {
+            return std::runtime_error(what + " " + name + ": " + std::strerror(errno));
+        }
+
+        void pack(const IndicatorValues &v, std::uint64_t *w)
+        {
+            w[0] = static_cast<std::uint64_t>(v.timestamp);
+            w[1] = std::bit_cast<std::uint64_t>(v.close);
+            w[2] = std::bit_cast<std::uint64_t>(v.twma);
+            w[3] = std::bit_cast<std::uint64_t>(v.vwma);
+            w[4] = std::bit_cast<std::uint64_t>(v.cumulativeReturn);
+            w[5] = std::bit_cast<std::uint64_t>(v.volatility);
+            w[6] = std::bit_cast<std::uint64_t>(v.sharpe);
+            w[7] = std::bit_cast<std::uint64_t>(v.maxDrawdown);
+            w[8] = v.publishedNs;
+            w[9] = v.updates;
+        }
+
+        IndicatorValues unpack(const std::uint64_t *w)
+        {
+            IndicatorValues v;
+            v.timestamp = static_cast<EpochSeconds>(w[0]);
+            v.close = std::bit_cast<double>(w[1]);
+            v.twma = std::bit_cast<double>(w[2]);
+            v.vwma = std::bit_cast<double>(w[3]);
+            v.cumulativeReturn = std::bit_cast<double>(w[4]);
+            v.volatility = std::bit_cast<double>(w[5]);
+            v.sharpe = std::bit_cast<double>(w[6]);
+            v.maxDrawdown = std::bit_cast<double>(w[7]);
+            v.publishedNs = w[8];
+            v.updates = w[9];
+            return v;
+        }
+    } // namespace
+
+    IndicatorPublisher::IndicatorPublisher(std::string name, std::size_t capacity, ExistingRegion existing)
+        : name_(std::move(name)), capacity_(capacity)
+    {
+        if (capacity_ == 0 || capacity_ > 0xFFFFFFFFu)
+        {
+            throw std::invalid_argument("Invalid argument: capacity must be in [1, 2^32)");
+        }
+        bytes_ = regionBytes(capacity_);
+
+        int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0 && errno == EEXIST && existing == ExistingRegion::Replace)
+        {
+            shm_unlink(name_.c_str()); // drop a region left behind by a crashed writer
+            fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        }
+        if (fd < 0)
+        {
+            if (errno == EEXIST)
+            {
+                throw std::runtime_error("indicator feed " + name_ +
+                                         " already exists (pass ExistingRegion::Replace to recover a stale one)");
+            }
+            throw systemError("cannot create shared memory", name_);
+        }
+        struct stat st{};
+        if (fstat(fd, &st) != 0)
+        {
+            const auto error = systemError("cannot stat shared memory", name_);
+            close(fd);
+            shm_unlink(name_.c_str());
+            throw error;
+        }
+        device_ = static_cast<std::uint64_t>(st.st_dev);
+        inode_ = static_cast<std::uint64_t>(st.st_ino);
+        if (ftruncate(fd, static_cast<off_t>(bytes_)) != 0)
+        {
+            const auto error = systemError("cannot size shared memory", name_);
+            close(fd);
+            shm_unlink(name_.c_str());
+            throw error;
+        }
+        void *mapped = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED)
+        {
+            const auto error = systemError("cannot map shared memory", name_);
+            shm_unlink(name_.c_str());
+            throw error;
+        }
+        base_ = mapped;
+
+        FeedSlot *s = slots(base_);
+        for (std::size_t i = 0; i < capacity_; ++i)
+        {
+            new (&s[i]) FeedSlot{};
+        }
+        FeedHeader *h = new (base_) FeedHeader{};
+        h->version = kIndicatorFeedVersion;
+        h->capacity = static_cast<std::uint32_t>(capacity_);
+        h->symbolCount.store(0, std::memory_order_relaxed);
+        h->magic.store(kFeedMagic, std::memory_order_release);
+    }
+
+    IndicatorPublisher::~IndicatorPublisher()
+    {
+        munmap(base_, bytes_);
+
+        // A replacement publisher may own the name by now; leave its region alone.
+        const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+        {
+            return;
+        }
+        struct stat st{};
+        const bool ours = fstat(fd, &st) == 0 && static_cast<std::uint64_t>(st.st_dev) == device_ &&
+                          static_cast<std::uint64_t>(st.st_ino) == inode_;
+        close(fd);
+        if (ours)
+        {
+            shm_unlink(name_.c_str());
+        }
+    }
+
+    std::size_t IndicatorPublisher::symbolCount() const noexcept
+    {
+        return header(static_cast<const void *>(base_))->symbolCount.load(std::memory_order_acquire);
+    }
+
+    std::size_t IndicatorPublisher::addSymbol(const std::string &symbol)
+    {
+        if (symbol.size() > kIndicatorFeedMaxSymbol)
+        {
+            throw std::length_error("symbol too long for indicator feed: " + symbol);
+        }
+
+        FeedHeader *h = header(base_);
+        FeedSlot *s = slots(base_);
+        const std::size_t count = h->symbolCount.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (symbol == s[i].symbol)
+            {
+                return i;
+            }
+        }
+        if (count == capacity_)
+        {
+            throw std::length_error("indicator feed is full");
+        }
+
+        // The name is immutable once the count makes it visible.
+        std::memcpy(s[count].symbol, symbol.c_str(), symbol.size() + 1);
+        h->symbolCount.store(static_cast<std::uint32_t>(count + 1), std::memory_order_release);
+        return count;
+    }
+
+    IndicatorValues IndicatorPublisher::publish(std::size_t slot, const IndicatorValues &values)
+    {
+        TRADING_COUNTER_ADD("indicator_feed.publish", 1);
+
+        if (slot >= symbolCount())
+        {
+            throw std::out_of_range("indicator feed slot out of range");
+        }
+        FeedSlot &s = slots(base_)[slot];
+
+        const std::uint64_t seq = s.sequence.load(std::memory_order_relaxed);
+        IndicatorValues stamped = values;
+        stamped.publishedNs = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+        stamped.updates = seq / 2 + 1;
+        std::uint64_t words[kPayloadWords];
+        pack(stamped, words);
+
+        s.sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kPayloadWords; ++i)
+        {
+            s.words[i].store(words[i], std::memory_order_relaxed);
+        }
+        s.sequence.store(seq + 2, std::memory_order_release);
+        return stamped;
+    }
+
+    IndicatorReader::IndicatorReader(const std::string &name)
+    {
+        const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+        {
+            throw systemError("cannot open shared memory", name);
+        }
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(FeedHeader))
+        {
+            close(fd);
+            throw std::runtime_error("indicator feed " + name + " is too small");
+        }
+        bytes_ = static_cast<std::size_t>(st.st_size);
+        void *mapped = mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED)
+        {
+            throw systemError("cannot map shared memory", name);
+        }
+        base_ = mapped;
+
+        const FeedHeader *h = header(base_);
+        if (h->magic.load(std::memory_order_acquire) != kFeedMagic || h->version != kIndicatorFeedVersion ||
+            regionBytes(h->capacity) > bytes_)
+        {
+            munmap(const_cast<void *>(base_), bytes_);
+            throw std::runtime_error("indicator feed " + name + " has an unsupported layout");
+        }
+        capacity_ = h->capacity;
+    }
+
+    IndicatorReader::~IndicatorReader()
+    {
+        munmap(const_cast<void *>(base_), bytes_);
+    }
+
+    std::size_t IndicatorReader::symbolCount() const noexcept
+    {
+        return header(base_)->symbolCount.load(std::memory_order_acquire);
+    }
+
+    std::string IndicatorReader::symbol(std::size_t slot) const
+    {
+        if (slot >= symbolCount())
+        {
+            throw std::out_of_range("indicator feed slot out of range");
+        }
+        return slots(base_)[slot].symbol;
+    }
+
+    std::optional<std::size_t> IndicatorReader::findSymbol(const std::string &symbol) const
+    {
+        const std::size_t count = symbolCount();
+        const FeedSlot *s = slots(base_);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (symbol == s[i].symbol)
+            {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::optional<IndicatorValues> IndicatorReader::read(std::size_t slot) const
+    {
+        if (slot >= symbolCount())
+        {
+            throw std::out_of_range("indicator feed slot out of range");
+        }
+        const FeedSlot &s = slots(base_)[slot];
+
+        // Back-off for a write in progress: spin briefly, then yield. A sequence
+        // that stays at the same odd value means the writer stopped mid-publish.
+        constexpr std::size_t kSpinsBeforeYield = 64;
+        std::uint64_t pending = 0;
+        std::size_t spins = 0;
+        std::chrono::steady_clock::time_point pendingSince;
+
+        std::uint64_t words[kPayloadWords];
+        for (;;)
+        {
+            const std::uint64_t before = s.sequence.load(std::memory_order_acquire);
+            if (before == 0)
+            {
+                return std::nullopt;
+            }
+            if (before & 1u)
+            {
+                if (before != pending)
+                {
+                    pending = before;
+                    spins = 0;
+                    pendingSince = std::chrono::steady_clock::now();
+                }
+                else if (++spins < kSpinsBeforeYield)
+                {
+                    cpuRelax();
+                }
+                else
+                {
+                    if (std::chrono::steady_clock::now() - pendingSince > kIndicatorFeedStallTimeout)
+                    {
+                        throw std::runtime_error("indicator feed writer stalled on slot " + std::to_string(slot));
+                    }
+                    std::this_thread::yield();
+                }
+                continue;
+            }
+            for (std::size_t i = 0; i < kPayloadWords; ++i)
+            {
+                words[i] = s.words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s.sequence.load(std::memory_order_relaxed) == before)
+            {
+                return unpack(words);
+            }
+        }
+    }
+
+    std::uint64_t IndicatorReader::updates(std::size_t slot) const
+    {
+        if (slot >= symbolCount())
+        {
+            throw std::out_of_range("indicator feed slot out of range");
+        }
+        return slots(base_)[slot].sequence.load(std::memory_order_acquire) / 2;
+    }
+
+    PublishedIndicators::PublishedIndicators(IndicatorPublisher &publisher,
+                                             const std::string &symbol,
+                                             double twmaTimeConstantDays,
+                                             std::size_t vwmaWindow,
+                                             std::size_t rollingWindow,
+                                             int periods_per_year)
+        : publisher_(publisher),
+          slot_(publisher.addSymbol(symbol)),
+          twma_(twmaTimeConstantDays),
+          vwma_(vwmaWindow),
+          rolling_(rollingWindow, periods_per_year)
+    {
+    }
+
+    const IndicatorValues &PublishedIndicators::update(const Bar &bar)
+    {
+        // Validate everything that can throw before touching any indicator state.
+        if (!(bar.close > 0.0))
+        {
+            throw std::invalid_argument("bar close must be > 0 to compute returns");
+        }
+        const EpochSeconds timestamp = toEpochSeconds(bar.date, bar.time);
+
+        if (firstClose_ == 0.0)
+        {
+            firstClose_ = bar.close;
+        }
+
+        IndicatorValues next = latest_;
+        next.timestamp = timestamp;
+        next.close = bar.close;
+        next.twma = twma_.update(bar);
+        next.vwma = vwma_.update(bar);
+        if (rolling_.update(bar.close / firstClose_))
+        {
+            const RollingMetricsValue m = rolling_.value();
+            next.cumulativeReturn = m.cumulative_return;
+            next.volatility = m.volatility;
+            next.sharpe = m.sharpe;
+            next.maxDrawdown = m.max_drawdown;
+        }
+
+        latest_ = publisher_.publish(slot_, next);
+        return latest_;
+    }
+
+} // namespace trading
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+
+#include "core/bar.h"
+#include "core/timestamp.h"
+#include "metrics/moving_average.h"
+#include "metrics/rolling_metrics.h"
+
+namespace trading
+{
+
+    // Latest indicator values of one symbol as seen by other processes.
+    // Rolling metric fields are NaN until their window is full.
+    struct IndicatorValues
+    {
+        EpochSeconds timestamp = 0;
+        double close = std::numeric_limits<double>::quiet_NaN();
+        double twma = std::numeric_limits<double>::quiet_NaN();
+        double vwma = std::numeric_limits<double>::quiet_NaN();
+        double cumulativeReturn = std::numeric_limits<double>::quiet_NaN();
+        double volatility = std::numeric_limits<double>::quiet_NaN();
+        double sharpe = std::numeric_limits<double>::quiet_NaN();
+        double maxDrawdown = std::numeric_limits<double>::quiet_NaN();
+        std::uint64_t publishedNs = 0; // steady_clock (CLOCK_MONOTONIC) time of publish(), set by the publisher
+        std::uint64_t updates = 0;     // number of publishes to this slot, set by the publisher
+    };
+
+    // Shared-memory layout version; readers reject other versions.
+    constexpr std::uint32_t kIndicatorFeedVersion = 1;
+
+    // How long a reader waits on a slot whose sequence stays odd (a writer that
+    // died mid-publish) before giving up.
+    constexpr std::chrono::milliseconds kIndicatorFeedStallTimeout{100};
+
+    // Longest symbol a slot can hold.
+    constexpr std::size_t kIndicatorFeedMaxSymbol = 31;
+
+    // What IndicatorPublisher does when a region with its name already exists.
+    enum class ExistingRegion
+    {
+        Fail,   // throw: another publisher may still be live
+        Replace // unlink it first (recovering a region left by a crashed writer)
+    };
+
+    // Writer side of a POSIX shared-memory region (shm_open name, e.g.
+    // "/trading_indicators") holding one slot per symbol.
+    //
+    // Every slot is guarded by a seqlock: publish() bumps the slot sequence to
+    // odd, stores the values, and bumps it back to even. The writer never
+    // waits for readers; readers retry when they observe a write in progress.
+    // One thread publishes to a given slot at a time.
+    class IndicatorPublisher
+    {
+    public:
+        // Create the region with room for capacity symbols. Throws
+        // std::runtime_error if the name is taken, unless existing is Replace.
+        IndicatorPublisher(std::string name, std::size_t capacity, ExistingRegion existing = ExistingRegion::Fail);
+
+        // Unmaps, and unlinks the name if it still refers to this region;
+        // mapped readers keep their view.
+        ~IndicatorPublisher();
+
+        IndicatorPublisher(const IndicatorPublisher &) = delete;
+        IndicatorPublisher &operator=(const IndicatorPublisher &) = delete;
+
+        // Slot of symbol, registering it on first use. Throws std::length_error
+        // when the region is full or the symbol is too long.
+        std::size_t addSymbol(const std::string &symbol);
+
+        // Publish values to a slot. Returns them as published, with
+        // publishedNs and updates filled in.
+        IndicatorValues publish(std::size_t slot, const IndicatorValues &values);
+
+        const std::string &name() const noexcept { return name_; }
+        std::size_t capacity() const noexcept { return capacity_; }
+        std::size_t symbolCount() const noexcept;
+
+    private:
+        std::string name_;
+        std::size_t capacity_;
+        std::size_t bytes_ = 0;
+        void *base_ = nullptr;
+        std::uint64_t device_ = 0; // identity of the created region
+        std::uint64_t inode_ = 0;
+    };
+
+    // Read-only view of a region created by IndicatorPublisher.
+    class IndicatorReader
+    {
+    public:
+        // Throws std::runtime_error if the region does not exist or has an
+        // unexpected layout.
+        explicit IndicatorReader(const std::string &name);
+        ~IndicatorReader();
+
+        IndicatorReader(const IndicatorReader &) = delete;
+        IndicatorReader &operator=(const IndicatorReader &) = delete;
+
+        std::size_t symbolCount() const noexcept;
+        std::string symbol(std::size_t slot) const;
+        std::optional<std::size_t> findSymbol(const std::string &symbol) const;
+
+        // Consistent copy of a slot; nullopt until its first publish. Throws
+        // std::runtime_error if a write stays in progress for longer than
+        // kIndicatorFeedStallTimeout.
+        std::optional<IndicatorValues> read(std::size_t slot) const;
+
+        // Number of completed publishes to a slot, without copying the values.
+        // Cheap enough to poll for changes.
+        std::uint64_t updates(std::size_t slot) const;
+
+    private:
+        std::size_t capacity_ = 0;
+        std::size_t bytes_ = 0;
+        const void *base_ = nullptr;
+    };
+
+    // TWMA, VWMA and rolling metrics of one symbol, published after every bar.
+    // The rolling metrics run on the buy-and-hold equity of the closes.
+    class PublishedIndicators
+    {
+    public:
+        PublishedIndicators(IndicatorPublisher &publisher,
+                            const std::string &symbol,
+                            double twmaTimeConstantDays,
+                            std::size_t vwmaWindow,
+                            std::size_t rollingWindow,
+                            int periods_per_year = 245);
+
+        // Update every indicator with the bar and publish the result. The bar is
+        // validated first (close > 0, parseable date/time); a rejected bar
+        // throws and leaves every indicator unchanged.
+        const IndicatorValues &update(const Bar &bar);
+
+        // Last published values, including publishedNs and updates.
+        const IndicatorValues &latest() const noexcept { return latest_; }
+        std::size_t slot() const noexcept { return slot_; }
+
+    private:
+        IndicatorPublisher &publisher_;
+        std::size_t slot_;
+        TimeWeightedMovingAverage twma_;
+        VolumeWeightedMovingAverage vwma_;
+        RollingWindowMetrics rolling_;
+        double firstClose_ = 0.0;
+        IndicatorValues latest_;
+    };
+
+} // namespace trading
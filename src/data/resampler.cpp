@@ -0,0 +1,298 @@
+#include "data/resampler.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+#include "core/instrumentation.h"
+#include "core/parallel.h"
+
+namespace trading
+{
+    namespace
+    {
+        constexpr EpochSeconds kSecondsPerDay = 86400;
+        // 1970-01-05 was the first Monday after the epoch.
+        constexpr EpochSeconds kFirstMonday = 4 * kSecondsPerDay;
+
+        EpochSeconds floorDiv(EpochSeconds a, EpochSeconds b)
+        {
+            const EpochSeconds q = a / b;
+            return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+        }
+
+        Bar makeBar(const std::string &symbol, const std::string &period, EpochSeconds bucket,
+                    double open, double high, double low, double close, double volume, std::uint64_t openInterest)
+        {
+            return Bar{symbol, period, formatDate(bucket), formatTime(bucket),
+                       open, high, low, close, volume, openInterest};
+        }
+
+        // Throws if bars of the source <PER> code are longer than the target.
+        // Codes ResamplePeriod does not know are not checked.
+        void checkSourcePeriod(const std::string &code, const ResamplePeriod &target)
+        {
+            std::optional<EpochSeconds> length;
+            try
+            {
+                length = ResamplePeriod::fromCode(code).lengthSeconds();
+            }
+            catch (const std::invalid_argument &)
+            {
+                return;
+            }
+            if (*length > target.lengthSeconds())
+            {
+                throw std::invalid_argument("cannot resample period " + code + " to the finer period " + target.code());
+            }
+        }
+    } // namespace
+
+    ResamplePeriod::ResamplePeriod(EpochSeconds length, EpochSeconds offset, std::string code)
+        : length_(length), offset_(offset), code_(std::move(code))
+    {
+    }
+
+    ResamplePeriod ResamplePeriod::minutes(unsigned n)
+    {
+        if (n == 0)
+        {
+            throw std::invalid_argument("Invalid argument: resample period must be > 0");
+        }
+        return ResamplePeriod(static_cast<EpochSeconds>(n) * 60, 0, std::to_string(n));
+    }
+
+    ResamplePeriod ResamplePeriod::hours(unsigned n)
+    {
+        if (n > std::numeric_limits<unsigned>::max() / 60)
+        {
+            throw std::invalid_argument("Invalid argument: resample period of " + std::to_string(n) +
+                                        " hours is too long");
+        }
+        return minutes(n * 60);
+    }
+
+    ResamplePeriod ResamplePeriod::days()
+    {
+        return ResamplePeriod(kSecondsPerDay, 0, "D");
+    }
+
+    ResamplePeriod ResamplePeriod::weeks()
+    {
+        return ResamplePeriod(7 * kSecondsPerDay, kFirstMonday, "W");
+    }
+
+    ResamplePeriod ResamplePeriod::fromCode(const std::string &code)
+    {
+        if (code == "D")
+        {
+            return days();
+        }
+        if (code == "W")
+        {
+            return weeks();
+        }
+        if (!code.empty() && std::all_of(code.begin(), code.end(), [](char c)
+                                         { return c >= '0' && c <= '9'; }))
+        {
+            return minutes(static_cast<unsigned>(std::stoul(code)));
+        }
+        throw std::invalid_argument("unsupported period code: " + code);
+    }
+
+    EpochSeconds ResamplePeriod::bucketStart(EpochSeconds t) const noexcept
+    {
+        return floorDiv(t - offset_, length_) * length_ + offset_;
+    }
+
+    BarResampler::BarResampler(ResamplePeriod period)
+        : period_(std::move(period))
+    {
+    }
+
+    void BarResampler::reset()
+    {
+        current_.reset();
+        currentBucket_ = 0;
+        checkedPeriod_.clear();
+    }
+
+    std::optional<Bar> BarResampler::update(const Bar &bar)
+    {
+        // Same rule as resampleColumns; a stream rarely changes period, so the
+        // code is only parsed when it does.
+        if (bar.period != checkedPeriod_)
+        {
+            checkSourcePeriod(bar.period, period_);
+            checkedPeriod_ = bar.period;
+        }
+
+        const EpochSeconds bucket = period_.bucketStart(toEpochSeconds(bar.date, bar.time));
+
+        if (current_)
+        {
+            if (bar.symbol != current_->symbol)
+            {
+                throw std::invalid_argument("BarResampler handles one symbol; got " + bar.symbol);
+            }
+            if (bucket < currentBucket_)
+            {
+                throw std::invalid_argument("bars must be in time order");
+            }
+            if (bucket == currentBucket_)
+            {
+                current_->high = std::max(current_->high, bar.high);
+                current_->low = std::min(current_->low, bar.low);
+                current_->close = bar.close;
+                current_->volume += bar.volume;
+                current_->openInterest = bar.openInterest;
+                return std::nullopt;
+            }
+        }
+
+        std::optional<Bar> completed = std::move(current_);
+        current_ = makeBar(bar.symbol, period_.code(), bucket,
+                           bar.open, bar.high, bar.low, bar.close, bar.volume, bar.openInterest);
+        currentBucket_ = bucket;
+        return completed;
+    }
+
+    std::optional<Bar> BarResampler::flush()
+    {
+        std::optional<Bar> completed = std::move(current_);
+        current_.reset();
+        return completed;
+    }
+
+    BarColumns resampleColumns(const BarColumns &in, const ResamplePeriod &period)
+    {
+        TRADING_TRACE_SCOPE("resampleColumns");
+
+        BarColumns out;
+        const std::size_t n = in.size();
+        if (n == 0)
+        {
+            return out;
+        }
+
+        // The rows must be one symbol, at periods no longer than the target.
+        SymbolId checkedPeriod = in.periodIds[0];
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (in.symbolIds[i] != in.symbolIds[0])
+            {
+                throw std::invalid_argument("resampleColumns expects a single symbol; use resampleBySymbol");
+            }
+            if (i == 0 || in.periodIds[i] != checkedPeriod)
+            {
+                checkedPeriod = in.periodIds[i];
+                checkSourcePeriod(periodTable().name(checkedPeriod), period);
+            }
+        }
+
+        // Pass 1: bucket of every row and the number of output rows.
+        std::vector<EpochSeconds> buckets(n);
+        std::size_t groups = 1;
+        buckets[0] = period.bucketStart(in.timestamps[0]);
+        for (std::size_t i = 1; i < n; ++i)
+        {
+            buckets[i] = period.bucketStart(in.timestamps[i]);
+            if (buckets[i] < buckets[i - 1])
+            {
+                throw std::invalid_argument("bars must be in time order");
+            }
+            groups += (buckets[i] != buckets[i - 1]);
+        }
+
+        // Pass 2: reduce each run of equal buckets.
+        out.resize(groups);
+        const SymbolId periodId = periodTable().intern(period.code());
+        std::size_t g = 0;
+        std::size_t begin = 0;
+        for (std::size_t i = 1; i <= n; ++i)
+        {
+            if (i < n && buckets[i] == buckets[begin])
+            {
+                continue;
+            }
+
+            double high = in.high[begin];
+            double low = in.low[begin];
+            double volume = 0.0;
+            for (std::size_t k = begin; k < i; ++k)
+            {
+                high = std::max(high, in.high[k]);
+                low = std::min(low, in.low[k]);
+                volume += in.volume[k];
+            }
+
+            out.symbolIds[g] = in.symbolIds[begin];
+            out.periodIds[g] = periodId;
+            out.timestamps[g] = buckets[begin];
+            out.open[g] = in.open[begin];
+            out.high[g] = high;
+            out.low[g] = low;
+            out.close[g] = in.close[i - 1];
+            out.volume[g] = volume;
+            out.openInterest[g] = in.openInterest[i - 1];
+            ++g;
+            begin = i;
+        }
+
+        return out;
+    }
+
+    std::vector<Bar> resampleBars(const std::vector<Bar> &bars, const ResamplePeriod &period)
+    {
+        if (bars.empty())
+        {
+            return {};
+        }
+
+        const std::string &symbol = bars.front().symbol;
+        for (const Bar &bar : bars)
+        {
+            if (bar.symbol != symbol)
+            {
+                throw std::invalid_argument("resampleBars expects a single symbol; use resampleBySymbol");
+            }
+        }
+
+        const BarColumns out = resampleColumns(toColumns(bars), period);
+
+        std::vector<Bar> result;
+        result.reserve(out.size());
+        for (std::size_t i = 0; i < out.size(); ++i)
+        {
+            result.push_back(makeBar(symbol, period.code(), out.timestamps[i],
+                                     out.open[i], out.high[i], out.low[i], out.close[i],
+                                     out.volume[i], out.openInterest[i]));
+        }
+        return result;
+    }
+
+    std::vector<Bar> resampleBySymbol(const std::vector<Bar> &bars, const ResamplePeriod &period, std::size_t threads)
+    {
+        TRADING_TRACE_SCOPE("resampleBySymbol");
+
+        // Group rows by interned symbol id, in order of first appearance.
+        const BarColumns columns = toColumns(bars);
+        const std::vector<SymbolRows> groups = groupBySymbol(columns);
+
+        std::vector<BarColumns> resampled(groups.size());
+        parallelFor(groups.size(), threads, [&](std::size_t g)
+        {
+            resampled[g] = resampleColumns(selectRows(columns, groups[g].rows), period);
+        });
+
+        std::vector<Bar> result;
+        for (const BarColumns &group : resampled)
+        {
+            std::vector<Bar> groupBars = toBars(group);
+            result.insert(result.end(), std::make_move_iterator(groupBars.begin()), std::make_move_iterator(groupBars.end()));
+        }
+        return result;
+    }
+
+} // namespace trading
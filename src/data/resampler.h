@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/bar.h"
+#include "core/bar_columns.h"
+
+namespace trading
+{
+
+    // Target period of a resample. Buckets are aligned to the epoch (minutes,
+    // hours, days) or to Mondays (weeks), and labelled with their start time.
+    class ResamplePeriod
+    {
+    public:
+        static ResamplePeriod minutes(unsigned n);
+        static ResamplePeriod hours(unsigned n);
+        static ResamplePeriod days();
+        static ResamplePeriod weeks();
+
+        // Parse a <PER> code: a number of minutes ("5", "60"), "D" or "W".
+        static ResamplePeriod fromCode(const std::string &code);
+
+        // <PER> code written to resampled bars.
+        const std::string &code() const noexcept { return code_; }
+
+        EpochSeconds lengthSeconds() const noexcept { return length_; }
+
+        // Start of the bucket containing t.
+        EpochSeconds bucketStart(EpochSeconds t) const noexcept;
+
+    private:
+        ResamplePeriod(EpochSeconds length, EpochSeconds offset, std::string code);
+
+        EpochSeconds length_;
+        EpochSeconds offset_;
+        std::string code_;
+    };
+
+    // Incremental resampler for one symbol's live bar stream.
+    // Bars must arrive in time order; the output bar carries the first bar's
+    // open, the max high, min low, last close, summed volume and last open interest.
+    class BarResampler
+    {
+    public:
+        explicit BarResampler(ResamplePeriod period);
+
+        // Reset internal state
+        void reset();
+
+        // Feed the next finer bar. Returns the previous bucket once a bar from a
+        // later bucket arrives. Throws std::invalid_argument if the bar's period
+        // is longer than the target.
+        std::optional<Bar> update(const Bar &bar);
+
+        // Return the bucket in progress (if any) and clear it.
+        std::optional<Bar> flush();
+
+    private:
+        ResamplePeriod period_;
+        std::optional<Bar> current_;
+        EpochSeconds currentBucket_ = 0;
+        std::string checkedPeriod_; // source period already checked against period_
+    };
+
+    // Batch resample of one symbol's column series in time order. Output
+    // timestamps are bucket starts. Throws std::invalid_argument for mixed
+    // symbols or a target period finer than the source <PER>.
+    BarColumns resampleColumns(const BarColumns &columns, const ResamplePeriod &period);
+
+    // Batch resample of a single symbol's bars in time order (same checks).
+    std::vector<Bar> resampleBars(const std::vector<Bar> &bars, const ResamplePeriod &period);
+
+    // Resample a multi-symbol series. Bars are grouped by symbol (each group must
+    // be in time order), groups run in parallel on up to `threads` threads
+    // (0 = all cores), and the output lists symbols in order of first appearance.
+    std::vector<Bar> resampleBySymbol(const std::vector<Bar> &bars, const ResamplePeriod &period, std::size_t threads = 0);
+
+} // namespace trading
@@ -0,0 +1,428 @@
+#include "data/snapshot.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include "core/instrumentation.h"
+#include "metrics/moving_average.h"
+#include "metrics/rolling_metrics.h"
+
+namespace trading
+{
+    namespace
+    {
+        static_assert(std::endian::native == std::endian::little,
+                      "snapshot format assumes a little-endian target");
+
+        constexpr char kMagic[4] = {'T', 'S', 'N', 'P'};
+        constexpr std::size_t kHeaderSize = sizeof(kMagic) + 2 * sizeof(std::uint32_t);
+        constexpr std::size_t kRecordCountOffset = sizeof(kMagic) + sizeof(std::uint32_t);
+
+        // A restored RollingWindowMetrics allocates its whole window up front, so
+        // larger windows (of any restored kind) are treated as corruption.
+        constexpr std::size_t kMaxRestoredWindow = std::size_t{1} << 24;
+
+        // Throws unless n items of itemSize bytes fit in the rest of the record.
+        // Checked before sizing anything from a count read out of the snapshot.
+        void requirePayload(const SnapshotReader &r, std::size_t n, std::size_t itemSize)
+        {
+            if (n > r.remaining() / itemSize)
+            {
+                throw std::runtime_error("snapshot truncated");
+            }
+        }
+    } // namespace
+
+    // Friend of the streaming classes; the only code that touches their
+    // private state for serialisation.
+    struct SnapshotAccess
+    {
+        static void save(SnapshotWriter &w, const TimeWeightedMovingAverage &t)
+        {
+            w.writeF64(t.timeConstantDays_);
+            w.writeU8(t.initialized_ ? 1 : 0);
+            w.writeF64(t.ema_);
+            w.writeU64(static_cast<std::uint64_t>(t.lastDate_));
+        }
+
+        static void restore(SnapshotReader &r, TimeWeightedMovingAverage &t)
+        {
+            const double timeConstantDays = r.readF64();
+            if (!(timeConstantDays > 0.0))
+            {
+                throw std::runtime_error("snapshot TWMA has an invalid time constant");
+            }
+            TimeWeightedMovingAverage restored(timeConstantDays);
+            restored.initialized_ = r.readU8() != 0;
+            restored.ema_ = r.readF64();
+            restored.lastDate_ = static_cast<TimeWeightedMovingAverage::SysDays>(r.readU64());
+            t = restored;
+        }
+
+        static void save(SnapshotWriter &w, const VolumeWeightedMovingAverage &v)
+        {
+            w.writeU64(v.windowSize_);
+            w.writeU64(v.count_);
+            w.writeF64(v.sumPriceVolumeProduct_);
+            w.writeF64(v.sumVolume_);
+            w.writeU64(v.volumes_.size());
+            for (std::size_t i = 0; i < v.volumes_.size(); ++i)
+            {
+                w.writeF64(v.priceVolumeProducts_[i]);
+                w.writeF64(v.volumes_[i]);
+            }
+        }
+
+        static void restore(SnapshotReader &r, VolumeWeightedMovingAverage &v)
+        {
+            const auto window = static_cast<std::size_t>(r.readU64());
+            if (window == 0 || window > kMaxRestoredWindow)
+            {
+                throw std::runtime_error("snapshot VWMA window has an invalid size");
+            }
+            VolumeWeightedMovingAverage restored(window);
+            restored.count_ = static_cast<std::size_t>(r.readU64());
+            restored.sumPriceVolumeProduct_ = r.readF64();
+            restored.sumVolume_ = r.readF64();
+
+            // update() pops the oldest value once count_ passes the window, so
+            // the stored values must be exactly the last min(count_, window).
+            const auto n = static_cast<std::size_t>(r.readU64());
+            if (n != std::min(restored.count_, window))
+            {
+                throw std::runtime_error("snapshot VWMA window does not match its value count");
+            }
+            requirePayload(r, n, 2 * sizeof(double));
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                restored.priceVolumeProducts_.push_back(r.readF64());
+                restored.volumes_.push_back(r.readF64());
+            }
+            v = std::move(restored);
+        }
+
+        static void save(SnapshotWriter &w, const RollingWindowMetrics &m)
+        {
+            w.writeU64(m.window_);
+            w.writeU32(static_cast<std::uint32_t>(m.periods_per_year_));
+            w.writeU64(m.count_);
+            w.writeU64(m.evictions_);
+            for (std::size_t k = 0; k < m.count_; ++k)
+            {
+                w.writeF64(m.ring_[(m.head_ + k) % m.window_]);
+            }
+            w.writeU64(m.returnCount_);
+            w.writeF64(m.mean_);
+            w.writeF64(m.m2_);
+
+            w.writeU64(m.front_.size());
+            for (const auto &s : m.front_)
+            {
+                w.writeF64(s.max);
+                w.writeF64(s.min);
+                w.writeF64(s.drawdown);
+            }
+            w.writeU64(m.back_.size());
+            w.writeF64s(m.back_.data(), m.back_.size());
+            w.writeF64(m.backSummary_.max);
+            w.writeF64(m.backSummary_.min);
+            w.writeF64(m.backSummary_.drawdown);
+        }
+
+        static void restore(SnapshotReader &r, RollingWindowMetrics &m)
+        {
+            const auto window = static_cast<std::size_t>(r.readU64());
+            const auto ppy = static_cast<int>(r.readU32());
+            const auto count = static_cast<std::size_t>(r.readU64());
+            const auto evictions = static_cast<std::size_t>(r.readU64());
+            if (window < 3 || window > kMaxRestoredWindow || ppy <= 0)
+            {
+                throw std::runtime_error("snapshot rolling window has an invalid size or period count");
+            }
+            if (count > window || evictions >= window)
+            {
+                throw std::runtime_error("snapshot rolling window holds more values than its size");
+            }
+            requirePayload(r, count, sizeof(double));
+
+            RollingWindowMetrics restored(window, ppy);
+            restored.count_ = count;
+            restored.evictions_ = evictions;
+            r.readF64s(restored.ring_.data(), count);
+            restored.head_ = 0;
+            restored.returnCount_ = static_cast<std::size_t>(r.readU64());
+            restored.mean_ = r.readF64();
+            restored.m2_ = r.readF64();
+            if (restored.returnCount_ != ((count > 0) ? count - 1 : 0))
+            {
+                throw std::runtime_error("snapshot rolling return count does not match its values");
+            }
+
+            // The two drawdown stacks hold exactly the values of the window.
+            const auto nFront = static_cast<std::size_t>(r.readU64());
+            if (nFront > count)
+            {
+                throw std::runtime_error("snapshot rolling drawdown queue does not match its window");
+            }
+            requirePayload(r, nFront, 3 * sizeof(double));
+            restored.front_.resize(nFront);
+            for (auto &s : restored.front_)
+            {
+                s.max = r.readF64();
+                s.min = r.readF64();
+                s.drawdown = r.readF64();
+            }
+            const auto nBack = static_cast<std::size_t>(r.readU64());
+            if (nFront + nBack != count)
+            {
+                throw std::runtime_error("snapshot rolling drawdown queue does not match its window");
+            }
+            requirePayload(r, nBack, sizeof(double));
+            restored.back_.resize(nBack);
+            r.readF64s(restored.back_.data(), nBack);
+            restored.backSummary_.max = r.readF64();
+            restored.backSummary_.min = r.readF64();
+            restored.backSummary_.drawdown = r.readF64();
+
+            m = std::move(restored);
+        }
+    };
+
+    SnapshotWriter::SnapshotWriter()
+    {
+        buffer_.reserve(4096);
+        append(kMagic, sizeof(kMagic));
+        writeU32(kSnapshotVersion);
+        writeU32(0); // record count, patched by finish()
+    }
+
+    void SnapshotWriter::append(const void *data, std::size_t n)
+    {
+        const auto *bytes = static_cast<const std::uint8_t *>(data);
+        buffer_.insert(buffer_.end(), bytes, bytes + n);
+    }
+
+    void SnapshotWriter::beginRecord(SnapshotKind kind, std::string_view symbol)
+    {
+        if (inRecord_)
+        {
+            throw std::logic_error("SnapshotWriter: endRecord() missing");
+        }
+        if (symbol.size() > std::numeric_limits<std::uint16_t>::max())
+        {
+            throw std::invalid_argument("snapshot symbol too long");
+        }
+
+        writeU8(static_cast<std::uint8_t>(kind));
+        const auto len = static_cast<std::uint16_t>(symbol.size());
+        append(&len, sizeof(len));
+        append(symbol.data(), symbol.size());
+        writeU32(0); // payload length, patched by endRecord()
+        payloadStart_ = buffer_.size();
+        inRecord_ = true;
+    }
+
+    void SnapshotWriter::endRecord()
+    {
+        if (!inRecord_)
+        {
+            throw std::logic_error("SnapshotWriter: beginRecord() missing");
+        }
+        const auto payload = static_cast<std::uint32_t>(buffer_.size() - payloadStart_);
+        std::memcpy(buffer_.data() + payloadStart_ - sizeof(payload), &payload, sizeof(payload));
+        inRecord_ = false;
+        ++records_;
+    }
+
+    void SnapshotWriter::writeU8(std::uint8_t v)
+    {
+        buffer_.push_back(v);
+    }
+
+    void SnapshotWriter::writeU32(std::uint32_t v)
+    {
+        append(&v, sizeof(v));
+    }
+
+    void SnapshotWriter::writeU64(std::uint64_t v)
+    {
+        append(&v, sizeof(v));
+    }
+
+    void SnapshotWriter::writeF64(double v)
+    {
+        append(&v, sizeof(v));
+    }
+
+    void SnapshotWriter::writeF64s(const double *values, std::size_t n)
+    {
+        append(values, n * sizeof(double));
+    }
+
+    std::vector<std::uint8_t> SnapshotWriter::finish()
+    {
+        if (inRecord_)
+        {
+            throw std::logic_error("SnapshotWriter: endRecord() missing");
+        }
+        std::memcpy(buffer_.data() + kRecordCountOffset, &records_, sizeof(records_));
+        std::vector<std::uint8_t> out = std::move(buffer_);
+        buffer_.clear();
+        records_ = 0;
+        return out;
+    }
+
+    SnapshotReader::SnapshotReader(const std::vector<std::uint8_t> &buffer)
+        : buffer_(buffer)
+    {
+        if (buffer_.size() < kHeaderSize || std::memcmp(buffer_.data(), kMagic, sizeof(kMagic)) != 0)
+        {
+            throw std::runtime_error("not a snapshot buffer (bad magic)");
+        }
+        pos_ = sizeof(kMagic);
+        recordEnd_ = buffer_.size();
+        version_ = readU32();
+        if (version_ == 0 || version_ > kSnapshotVersion)
+        {
+            throw std::runtime_error("unsupported snapshot version " + std::to_string(version_));
+        }
+        records_ = readU32();
+        recordEnd_ = pos_;
+    }
+
+    void SnapshotReader::read(void *out, std::size_t n)
+    {
+        if (n > recordEnd_ - pos_)
+        {
+            throw std::runtime_error("snapshot truncated");
+        }
+        std::memcpy(out, buffer_.data() + pos_, n);
+        pos_ += n;
+    }
+
+    bool SnapshotReader::nextRecord(SnapshotRecord &record)
+    {
+        pos_ = recordEnd_;
+        if (recordsRead_ == records_)
+        {
+            return false;
+        }
+
+        recordEnd_ = buffer_.size();
+        record.kind = static_cast<SnapshotKind>(readU8());
+        std::uint16_t len = 0;
+        read(&len, sizeof(len));
+        record.symbol.resize(len);
+        read(record.symbol.data(), len);
+        record.payloadSize = readU32();
+        if (record.payloadSize > buffer_.size() - pos_)
+        {
+            throw std::runtime_error("snapshot truncated");
+        }
+        recordEnd_ = pos_ + record.payloadSize;
+        ++recordsRead_;
+        return true;
+    }
+
+    std::uint8_t SnapshotReader::readU8()
+    {
+        std::uint8_t v;
+        read(&v, sizeof(v));
+        return v;
+    }
+
+    std::uint32_t SnapshotReader::readU32()
+    {
+        std::uint32_t v;
+        read(&v, sizeof(v));
+        return v;
+    }
+
+    std::uint64_t SnapshotReader::readU64()
+    {
+        std::uint64_t v;
+        read(&v, sizeof(v));
+        return v;
+    }
+
+    double SnapshotReader::readF64()
+    {
+        double v;
+        read(&v, sizeof(v));
+        return v;
+    }
+
+    void SnapshotReader::readF64s(double *values, std::size_t n)
+    {
+        read(values, n * sizeof(double));
+    }
+
+    void saveState(SnapshotWriter &writer, const TimeWeightedMovingAverage &twma)
+    {
+        SnapshotAccess::save(writer, twma);
+    }
+
+    void saveState(SnapshotWriter &writer, const VolumeWeightedMovingAverage &vwma)
+    {
+        SnapshotAccess::save(writer, vwma);
+    }
+
+    void saveState(SnapshotWriter &writer, const RollingWindowMetrics &rolling)
+    {
+        SnapshotAccess::save(writer, rolling);
+    }
+
+    void restoreState(SnapshotReader &reader, TimeWeightedMovingAverage &twma)
+    {
+        SnapshotAccess::restore(reader, twma);
+    }
+
+    void restoreState(SnapshotReader &reader, VolumeWeightedMovingAverage &vwma)
+    {
+        SnapshotAccess::restore(reader, vwma);
+    }
+
+    void restoreState(SnapshotReader &reader, RollingWindowMetrics &rolling)
+    {
+        SnapshotAccess::restore(reader, rolling);
+    }
+
+    void writeSnapshotFile(const std::filesystem::path &path, const std::vector<std::uint8_t> &buffer)
+    {
+        TRADING_TRACE_SCOPE("writeSnapshotFile");
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            throw std::runtime_error("Failed to open snapshot file: " + path.string());
+        }
+        out.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        if (!out)
+        {
+            throw std::runtime_error("Failed to write snapshot file: " + path.string());
+        }
+    }
+
+    std::vector<std::uint8_t> readSnapshotFile(const std::filesystem::path &path)
+    {
+        TRADING_TRACE_SCOPE("readSnapshotFile");
+
+        if (!std::filesystem::exists(path))
+        {
+            throw std::runtime_error("Snapshot file not found: " + path.string());
+        }
+        std::ifstream in(path, std::ios::binary);
+        std::vector<std::uint8_t> buffer(std::filesystem::file_size(path));
+        in.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        if (!in)
+        {
+            throw std::runtime_error("Failed to read snapshot file: " + path.string());
+        }
+        return buffer;
+    }
+
+} // namespace trading
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace trading
+{
+
+    class TimeWeightedMovingAverage;
+    class VolumeWeightedMovingAverage;
+    class RollingWindowMetrics;
+
+    // Type tag of a snapshot record.
+    enum class SnapshotKind : std::uint8_t
+    {
+        TimeWeightedMovingAverage = 1,
+        VolumeWeightedMovingAverage = 2,
+        RollingWindowMetrics = 3
+    };
+
+    // Binary snapshot layout (little-endian):
+    //   header:  magic "TSNP", u32 version, u32 record count
+    //   record:  u8 kind, u16 symbol length, symbol bytes, u32 payload length, payload
+    // Readers skip records of unknown kinds using the payload length.
+    constexpr std::uint32_t kSnapshotVersion = 1;
+
+    // Serialises indicator state for many symbols into one contiguous buffer.
+    class SnapshotWriter
+    {
+    public:
+        SnapshotWriter();
+
+        // Start/finish one record. Payload writes go between the two calls.
+        void beginRecord(SnapshotKind kind, std::string_view symbol);
+        void endRecord();
+
+        void writeU8(std::uint8_t v);
+        void writeU32(std::uint32_t v);
+        void writeU64(std::uint64_t v);
+        void writeF64(double v);
+        void writeF64s(const double *values, std::size_t n);
+
+        std::size_t recordCount() const noexcept { return records_; }
+
+        // Patch the header and hand over the buffer. The writer is left empty.
+        std::vector<std::uint8_t> finish();
+
+    private:
+        void append(const void *data, std::size_t n);
+
+        std::vector<std::uint8_t> buffer_;
+        std::uint32_t records_ = 0;
+        std::size_t payloadStart_ = 0;
+        bool inRecord_ = false;
+    };
+
+    struct SnapshotRecord
+    {
+        SnapshotKind kind{};
+        std::string symbol;
+        std::size_t payloadSize = 0;
+    };
+
+    // Reads a buffer produced by SnapshotWriter. Throws std::runtime_error on a
+    // bad magic, unsupported version or truncated data. The reader refers to the
+    // buffer, which must outlive it; temporaries are rejected at compile time.
+    class SnapshotReader
+    {
+    public:
+        explicit SnapshotReader(const std::vector<std::uint8_t> &buffer);
+        explicit SnapshotReader(std::vector<std::uint8_t> &&) = delete;
+        explicit SnapshotReader(const std::vector<std::uint8_t> &&) = delete;
+
+        std::uint32_t version() const noexcept { return version_; }
+        std::uint32_t recordCount() const noexcept { return records_; }
+
+        // Advance to the next record; any unread payload of the current record
+        // is skipped. Returns false at the end of the snapshot.
+        bool nextRecord(SnapshotRecord &record);
+
+        std::uint8_t readU8();
+        std::uint32_t readU32();
+        std::uint64_t readU64();
+        double readF64();
+        void readF64s(double *values, std::size_t n);
+
+        // Bytes left in the current record (or header).
+        std::size_t remaining() const noexcept { return recordEnd_ - pos_; }
+
+    private:
+        void read(void *out, std::size_t n);
+
+        const std::vector<std::uint8_t> &buffer_;
+        std::size_t pos_ = 0;
+        std::size_t recordEnd_ = 0;
+        std::uint32_t version_ = 0;
+        std::uint32_t records_ = 0;
+        std::uint32_t recordsRead_ = 0;
+    };
+
+    // Save/restore the full internal state of each streaming object. A restored
+    // object continues bit-for-bit as if it had seen the original history.
+    void saveState(SnapshotWriter &writer, const TimeWeightedMovingAverage &twma);
+    void saveState(SnapshotWriter &writer, const VolumeWeightedMovingAverage &vwma);
+    void saveState(SnapshotWriter &writer, const RollingWindowMetrics &rolling);
+
+    void restoreState(SnapshotReader &reader, TimeWeightedMovingAverage &twma);
+    void restoreState(SnapshotReader &reader, VolumeWeightedMovingAverage &vwma);
+    void restoreState(SnapshotReader &reader, RollingWindowMetrics &rolling);
+
+    // Write a snapshot buffer to disk / read it back in one call.
+    void writeSnapshotFile(const std::filesystem::path &path, const std::vector<std::uint8_t> &buffer);
+    std::vector<std::uint8_t> readSnapshotFile(const std::filesystem::path &path);
+
+} // namespace trading
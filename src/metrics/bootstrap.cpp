@@ -0,0 +1,199 @@
+#include "metrics/bootstrap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "core/instrumentation.h"
+#include "core/parallel.h"
+#include "metrics/return_metrics.h"
+
+namespace trading
+{
+    namespace
+    {
+        constexpr std::uint64_t kGamma = 0x9e3779b97f4a7c15ULL;
+
+        // Paths handed to a worker at a time; each chunk reuses one set of buffers.
+        constexpr std::size_t kPathsPerChunk = 256;
+
+        std::uint64_t mix64(std::uint64_t z) noexcept
+        {
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+        void drawIndices(const BootstrapConfig &config, std::size_t n, CounterRng &rng, std::vector<std::size_t> &indices)
+        {
+            const std::size_t length = indices.size();
+            switch (config.method)
+            {
+            case BootstrapMethod::Iid:
+                for (std::size_t k = 0; k < length; ++k)
+                {
+                    indices[k] = rng.below(n);
+                }
+                break;
+            case BootstrapMethod::Block:
+            {
+                const auto block = static_cast<std::size_t>(std::max(1.0, std::round(config.block_length)));
+                for (std::size_t k = 0; k < length; k += block)
+                {
+                    const std::size_t start = rng.below(n);
+                    const std::size_t end = std::min(length, k + block);
+                    for (std::size_t j = k; j < end; ++j)
+                    {
+                        const std::size_t idx = start + (j - k);
+                        indices[j] = (idx < n) ? idx : idx % n;
+                    }
+                }
+                break;
+            }
+            case BootstrapMethod::Stationary:
+            {
+                const double restart = 1.0 / std::max(1.0, config.block_length);
+                std::size_t idx = rng.below(n);
+                indices[0] = idx;
+                for (std::size_t k = 1; k < length; ++k)
+                {
+                    idx = (rng.uniform() < restart) ? rng.below(n) : ((idx + 1 == n) ? 0 : idx + 1);
+                    indices[k] = idx;
+                }
+                break;
+            }
+            }
+        }
+    } // namespace
+
+    CounterRng::CounterRng(std::uint64_t seed, std::uint64_t stream) noexcept
+        : key_(mix64(seed ^ mix64(stream + kGamma)))
+    {
+    }
+
+    std::uint64_t CounterRng::next() noexcept
+    {
+        return mix64(key_ + kGamma * ++counter_);
+    }
+
+    double CounterRng::uniform() noexcept
+    {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+    std::size_t CounterRng::below(std::size_t n) noexcept
+    {
+        return std::min(static_cast<std::size_t>(uniform() * static_cast<double>(n)), n - 1);
+    }
+
+    BootstrapDistribution bootstrap_returns(const std::vector<double> &returns, const BootstrapConfig &config)
+    {
+        TRADING_TRACE_SCOPE("bootstrap_returns");
+
+        if (returns.empty())
+        {
+            throw std::invalid_argument("returns vector must not be empty");
+        }
+        if (config.paths == 0)
+        {
+            throw std::invalid_argument("paths must be > 0");
+        }
+        if (config.method != BootstrapMethod::Iid &&
+            !(config.block_length >= 1.0 && config.block_length <= static_cast<double>(returns.size())))
+        {
+            throw std::invalid_argument("block_length must be in [1, number of returns]");
+        }
+        for (double r : returns)
+        {
+            if (!(r > -1.0))
+            {
+                throw std::invalid_argument("returns must be > -1");
+            }
+        }
+
+        // Log-returns are drawn together with the returns so paths need no log1p.
+        std::vector<double> logReturns(returns.size());
+        for (std::size_t i = 0; i < returns.size(); ++i)
+        {
+            logReturns[i] = std::log1p(returns[i]);
+        }
+
+        const std::size_t n = returns.size();
+        const std::size_t length = (config.path_length > 0) ? config.path_length : n;
+        const double ppy = static_cast<double>(ReturnCalculator(config.periods_per_year).periods_per_year());
+
+        BootstrapDistribution dist;
+        dist.annualized_return.resize(config.paths);
+        dist.sharpe.resize(config.paths);
+        dist.max_drawdown.resize(config.paths);
+
+        const std::size_t chunks = (config.paths + kPathsPerChunk - 1) / kPathsPerChunk;
+        parallelFor(chunks, config.threads, [&](std::size_t chunk)
+        {
+            std::vector<std::size_t> indices(length);
+            std::vector<double> path(length);
+
+            const std::size_t first = chunk * kPathsPerChunk;
+            const std::size_t last = std::min(config.paths, first + kPathsPerChunk);
+            for (std::size_t p = first; p < last; ++p)
+            {
+                CounterRng rng(config.seed, p);
+                drawIndices(config, n, rng, indices);
+
+                double sumLog = 0.0;
+                double sum = 0.0;
+                for (std::size_t k = 0; k < length; ++k)
+                {
+                    path[k] = returns[indices[k]];
+                    sum += path[k];
+                    sumLog += logReturns[indices[k]];
+                }
+
+                const double mean = sum / static_cast<double>(length);
+                double ss = 0.0;
+                double equity = 1.0;
+                double peak = 1.0;
+                double maxDd = 0.0;
+                for (std::size_t k = 0; k < length; ++k)
+                {
+                    const double d = path[k] - mean;
+                    ss += d * d;
+                    equity *= 1.0 + path[k];
+                    peak = std::max(peak, equity);
+                    maxDd = std::max(maxDd, (peak - equity) / peak);
+                }
+
+                const double stdev = (length > 1) ? std::sqrt(ss / static_cast<double>(length - 1)) : 0.0;
+                dist.annualized_return[p] = std::expm1(sumLog / static_cast<double>(length) * ppy);
+                dist.sharpe[p] = (stdev > 0.0) ? mean / stdev * std::sqrt(ppy) : std::numeric_limits<double>::quiet_NaN();
+                dist.max_drawdown[p] = maxDd;
+            }
+        });
+
+        return dist;
+    }
+
+    double sample_quantile(std::vector<double> samples, double q)
+    {
+        samples.erase(std::remove_if(samples.begin(), samples.end(), [](double v)
+                                     { return std::isnan(v); }),
+                      samples.end());
+        if (samples.empty())
+        {
+            throw std::invalid_argument("samples must contain at least one non-NaN value");
+        }
+        if (q < 0.0 || q > 1.0)
+        {
+            throw std::invalid_argument("quantile must be in [0, 1]");
+        }
+
+        std::sort(samples.begin(), samples.end());
+        const double pos = q * static_cast<double>(samples.size() - 1);
+        const auto lo = static_cast<std::size_t>(pos);
+        const std::size_t hi = std::min(lo + 1, samples.size() - 1);
+        const double frac = pos - static_cast<double>(lo);
+        return samples[lo] + frac * (samples[hi] - samples[lo]);
+    }
+
+} // namespace trading
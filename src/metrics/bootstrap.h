@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace trading
+{
+
+    enum class BootstrapMethod
+    {
+        Iid,       // draw each return independently
+        Block,     // moving blocks of fixed length (circular)
+        Stationary // blocks of geometric length with the given mean (Politis-Romano)
+    };
+
+    struct BootstrapConfig
+    {
+        BootstrapMethod method = BootstrapMethod::Stationary;
+        std::size_t paths = 10000;
+        std::size_t path_length = 0; // 0 = same length as the input returns
+        double block_length = 20.0;  // block length (Block) or mean block length (Stationary); in [1, returns]
+        std::uint64_t seed = 0;
+        int periods_per_year = 245;
+        std::size_t threads = 0; // 0 = all cores
+    };
+
+    // One value per resampled path, in path order.
+    struct BootstrapDistribution
+    {
+        std::vector<double> annualized_return; // same definition as ReturnCalculator::from_returns
+        std::vector<double> sharpe;            // mean / stdev * sqrt(periods_per_year); NaN if stdev == 0
+        std::vector<double> max_drawdown;      // of the path's equity curve starting at 1.0
+    };
+
+    // Counter-based generator: the k-th draw of a stream is a pure function of
+    // (seed, stream, k), so path p produces the same numbers whichever thread
+    // runs it. Based on the SplitMix64 output function.
+    class CounterRng
+    {
+    public:
+        CounterRng(std::uint64_t seed, std::uint64_t stream) noexcept;
+
+        std::uint64_t next() noexcept;
+
+        // Uniform double in [0, 1).
+        double uniform() noexcept;
+
+        // Uniform integer in [0, n).
+        std::size_t below(std::size_t n) noexcept;
+
+    private:
+        std::uint64_t key_;
+        std::uint64_t counter_ = 0;
+    };
+
+    // Resample per-period arithmetic returns into config.paths synthetic paths
+    // and compute the distribution of annualized return, Sharpe and max drawdown.
+    // Results are bit-identical for any thread count.
+    BootstrapDistribution bootstrap_returns(const std::vector<double> &returns, const BootstrapConfig &config);
+
+    // q-quantile (0 <= q <= 1) of samples with linear interpolation; NaNs are ignored.
+    double sample_quantile(std::vector<double> samples, double q);
+
+} // namespace trading
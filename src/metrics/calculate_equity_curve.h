@@ -4,7 +4,7 @@
 #include <vector>
 
 #include "core/bar.h"
-#warning "USING calculate_equity_curve.h"
+#include "core/input_check.h"
 
 namespace trading
 {
@@ -12,9 +12,11 @@ namespace trading
     // Output length == bars.size()
     // equity[0] = starting_equity
     // equity[i] = equity[i-1] * (bars[i].close / bars[i-1].close)
+    // InputCheck::Unchecked skips the per-bar close > 0 check (for cleaned bars).
     std::vector<double> calculate_equity_curve_from_bars(
         const std::vector<Bar>& bars,
-        double starting_equity = 1.0
+        double starting_equity = 1.0,
+        InputCheck check = InputCheck::Checked
     );
 
     // Convenience: load bars using CSV loader then compute equity curve.
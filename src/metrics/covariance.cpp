@@ -0,0 +1,475 @@
+#include "metrics/covariance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "core/instrumentation.h"
+
+namespace trading
+{
+    namespace
+    {
+        // 64 x 64 doubles = 32 KiB output tile, which stays in L1/L2 while the
+        // matching input slices stream past it.
+        constexpr std::size_t kTile = 64;
+        constexpr std::size_t kRowChunk = 32;
+        // Below this many symbols a pass is too short to be worth waking threads.
+        constexpr std::size_t kParallelMinSymbols = 256;
+
+        bool runSerial(std::size_t n, const ThreadPool *pool)
+        {
+            return pool == nullptr || n < kParallelMinSymbols;
+        }
+
+        // Worker pool for n symbols, or null when passes stay on the calling thread.
+        std::unique_ptr<ThreadPool> makePool(std::size_t n, std::size_t threads)
+        {
+            if (threads == 1 || n < kParallelMinSymbols)
+            {
+                return nullptr;
+            }
+            return std::make_unique<ThreadPool>(threads);
+        }
+
+        // fn(i) for every row i of an n x n upper triangle, in row chunks.
+        // Rows are handed out dynamically, which balances the shrinking rows.
+        template <typename Fn>
+        void forEachUpperRow(std::size_t n, ThreadPool *pool, Fn &&fn)
+        {
+            if (runSerial(n, pool))
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    fn(i);
+                }
+                return;
+            }
+            pool->parallelFor((n + kRowChunk - 1) / kRowChunk, [&](std::size_t chunk)
+            {
+                const std::size_t end = std::min(n, (chunk + 1) * kRowChunk);
+                for (std::size_t i = chunk * kRowChunk; i < end; ++i)
+                {
+                    fn(i);
+                }
+            });
+        }
+
+        // out[i][j] = sum_t x[t][i] * x[t][j] for j >= i. x is time-major
+        // (rows x n). The upper triangle is cut into kTile x kTile tiles that run
+        // in parallel; inside a tile every time step is a rank-1 update whose
+        // inner loop is contiguous and free of reductions, so it vectorizes
+        // without relaxed floating-point flags. Diagonal tiles are computed
+        // whole; their lower halves are overwritten when mirroring.
+        void upperCrossProducts(const double *x, std::size_t rows, std::size_t n, double *out, ThreadPool *pool)
+        {
+            const std::size_t tiles = (n + kTile - 1) / kTile;
+            std::vector<std::pair<std::size_t, std::size_t>> pairs;
+            pairs.reserve(tiles * (tiles + 1) / 2);
+            for (std::size_t bi = 0; bi < tiles; ++bi)
+            {
+                for (std::size_t bj = bi; bj < tiles; ++bj)
+                {
+                    pairs.emplace_back(bi, bj);
+                }
+            }
+
+            auto tile = [&](std::size_t p)
+            {
+                const std::size_t i0 = pairs[p].first * kTile;
+                const std::size_t i1 = std::min(n, i0 + kTile);
+                const std::size_t j0 = pairs[p].second * kTile;
+                const std::size_t j1 = std::min(n, j0 + kTile);
+
+                for (std::size_t i = i0; i < i1; ++i)
+                {
+                    std::fill(out + i * n + j0, out + i * n + j1, 0.0);
+                }
+                for (std::size_t t = 0; t < rows; ++t)
+                {
+                    const double *row = x + t * n;
+                    for (std::size_t i = i0; i < i1; ++i)
+                    {
+                        const double xi = row[i];
+                        double *outRow = out + i * n;
+                        for (std::size_t j = j0; j < j1; ++j)
+                        {
+                            outRow[j] += xi * row[j];
+                        }
+                    }
+                }
+            };
+
+            if (runSerial(n, pool))
+            {
+                for (std::size_t p = 0; p < pairs.size(); ++p)
+                {
+                    tile(p);
+                }
+            }
+            else
+            {
+                pool->parallelFor(pairs.size(), tile);
+            }
+        }
+
+        SymmetricMatrix fromUpper(const std::vector<double> &upper, std::size_t n, double scale)
+        {
+            SymmetricMatrix m;
+            m.size = n;
+            m.values.resize(n * n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                for (std::size_t j = i; j < n; ++j)
+                {
+                    const double v = upper[i * n + j] * scale;
+                    m.values[i * n + j] = v;
+                    m.values[j * n + i] = v;
+                }
+            }
+            return m;
+        }
+
+        void checkCrossSection(const std::vector<double> &returns, std::size_t symbols)
+        {
+            if (returns.size() != symbols)
+            {
+                throw std::invalid_argument("expected " + std::to_string(symbols) + " returns, got " +
+                                            std::to_string(returns.size()));
+            }
+        }
+    } // namespace
+
+    SymmetricMatrix covariance_matrix(const std::vector<std::vector<double>> &series, std::size_t threads)
+    {
+        TRADING_TRACE_SCOPE("covariance_matrix");
+
+        if (series.empty())
+        {
+            throw std::invalid_argument("Invalid argument: series must not be empty");
+        }
+        const std::size_t n = series.size();
+        const std::size_t rows = series.front().size();
+        if (rows < 2)
+        {
+            throw std::invalid_argument("Invalid argument: need at least 2 returns per series");
+        }
+        for (const auto &s : series)
+        {
+            if (s.size() != rows)
+            {
+                throw std::invalid_argument("Invalid argument: all series must have the same length");
+            }
+        }
+
+        // Centre each series (two-pass, so cancellation does not eat the
+        // small co-moments of returns) and transpose to time-major.
+        std::vector<double> centred(rows * n);
+        for (std::size_t s = 0; s < n; ++s)
+        {
+            double sum = 0.0;
+            for (double r : series[s])
+            {
+                sum += r;
+            }
+            const double mean = sum / static_cast<double>(rows);
+            for (std::size_t t = 0; t < rows; ++t)
+            {
+                centred[t * n + s] = series[s][t] - mean;
+            }
+        }
+
+        std::vector<double> upper(n * n);
+        const auto pool = makePool(n, threads);
+        upperCrossProducts(centred.data(), rows, n, upper.data(), pool.get());
+        return fromUpper(upper, n, 1.0 / static_cast<double>(rows - 1));
+    }
+
+    SymmetricMatrix correlation_matrix(const std::vector<std::vector<double>> &series, std::size_t threads)
+    {
+        return correlation_from_covariance(covariance_matrix(series, threads));
+    }
+
+    SymmetricMatrix correlation_from_covariance(const SymmetricMatrix &covariance)
+    {
+        const std::size_t n = covariance.size;
+        std::vector<double> invStdev(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double var = covariance(i, i);
+            invStdev[i] = (var > 0.0) ? 1.0 / std::sqrt(var) : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        SymmetricMatrix corr;
+        corr.size = n;
+        corr.values.resize(n * n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                corr.values[i * n + j] = covariance.values[i * n + j] * invStdev[i] * invStdev[j];
+            }
+            corr.values[i * n + i] = 1.0;
+        }
+        return corr;
+    }
+
+    EwmaCovariance::EwmaCovariance(std::size_t symbols, double timeConstantDays, std::size_t threads)
+        : EwmaCovariance(symbols, timeConstantDays, nullptr, threads)
+    {
+    }
+
+    EwmaCovariance::EwmaCovariance(std::size_t symbols, double timeConstantDays, ThreadPool &pool)
+        : EwmaCovariance(symbols, timeConstantDays, &pool, 0)
+    {
+    }
+
+    EwmaCovariance::EwmaCovariance(std::size_t symbols, double timeConstantDays, ThreadPool *pool, std::size_t threads)
+        : symbols_(symbols), timeConstantDays_(timeConstantDays), pool_(pool)
+    {
+        if (symbols_ == 0)
+        {
+            throw std::invalid_argument("Invalid argument: symbols must be > 0");
+        }
+        if (timeConstantDays_ <= 0.0)
+        {
+            throw std::invalid_argument("Invalid argument: time_constant_days must be > 0");
+        }
+        mean_.resize(symbols_);
+        upper_.resize(symbols_ * symbols_);
+        delta_.resize(symbols_);
+        if (pool_ == nullptr)
+        {
+            ownedPool_ = makePool(symbols_, threads);
+            pool_ = ownedPool_.get();
+        }
+    }
+
+    void EwmaCovariance::reset()
+    {
+        initialized_ = false;
+        lastTimestamp_ = 0;
+        std::fill(mean_.begin(), mean_.end(), 0.0);
+        std::fill(upper_.begin(), upper_.end(), 0.0);
+    }
+
+    void EwmaCovariance::update(EpochSeconds timestamp, const std::vector<double> &returns)
+    {
+        TRADING_COUNTER_ADD("ewma_covariance.update", 1);
+        checkCrossSection(returns, symbols_);
+
+        if (!initialized_)
+        {
+            mean_ = returns;
+            std::fill(upper_.begin(), upper_.end(), 0.0);
+            lastTimestamp_ = timestamp;
+            initialized_ = true;
+            return;
+        }
+
+        const double deltaDays = std::max(0.0, static_cast<double>(timestamp - lastTimestamp_) / 86400.0);
+        lastTimestamp_ = timestamp;
+        const double u = std::exp(-deltaDays / timeConstantDays_);
+        const double w = 1.0 - u;
+
+        // mean_n = u * mean_{n-1} + (1 - u) * x_n, the TWMA recursion, and
+        // cov_n = u * (cov_{n-1} + (1 - u) * d d^T) with d = x_n - mean_{n-1}.
+        for (std::size_t i = 0; i < symbols_; ++i)
+        {
+            delta_[i] = returns[i] - mean_[i];
+            mean_[i] += w * delta_[i];
+        }
+
+        const double *d = delta_.data();
+        double *c = upper_.data();
+        const std::size_t n = symbols_;
+        forEachUpperRow(n, pool_, [&](std::size_t i)
+        {
+            const double scale = u * w * d[i];
+            double *row = c + i * n;
+            for (std::size_t j = i; j < n; ++j)
+            {
+                row[j] = u * row[j] + scale * d[j];
+            }
+        });
+    }
+
+    SymmetricMatrix EwmaCovariance::covariance() const
+    {
+        if (!initialized_)
+        {
+            throw std::logic_error("EwmaCovariance has no value yet");
+        }
+        return fromUpper(upper_, symbols_, 1.0);
+    }
+
+    SymmetricMatrix EwmaCovariance::correlation() const
+    {
+        return correlation_from_covariance(covariance());
+    }
+
+    RollingCovariance::RollingCovariance(std::size_t symbols, std::size_t window, std::size_t threads)
+        : RollingCovariance(symbols, window, nullptr, threads)
+    {
+    }
+
+    RollingCovariance::RollingCovariance(std::size_t symbols, std::size_t window, ThreadPool &pool)
+        : RollingCovariance(symbols, window, &pool, 0)
+    {
+    }
+
+    RollingCovariance::RollingCovariance(std::size_t symbols, std::size_t window, ThreadPool *pool, std::size_t threads)
+        : symbols_(symbols), window_(window), pool_(pool)
+    {
+        if (symbols_ == 0)
+        {
+            throw std::invalid_argument("Invalid argument: symbols must be > 0");
+        }
+        if (window_ < 2)
+        {
+            throw std::invalid_argument("Invalid argument: window must be >= 2");
+        }
+        ring_.resize(window_ * symbols_);
+        mean_.resize(symbols_);
+        m2_.resize(symbols_ * symbols_);
+        added_.resize(symbols_);
+        removed_.resize(symbols_);
+        diff_.resize(symbols_);
+        if (pool_ == nullptr)
+        {
+            ownedPool_ = makePool(symbols_, threads);
+            pool_ = ownedPool_.get();
+        }
+    }
+
+    void RollingCovariance::reset()
+    {
+        head_ = 0;
+        count_ = 0;
+        evictions_ = 0;
+        std::fill(mean_.begin(), mean_.end(), 0.0);
+        std::fill(m2_.begin(), m2_.end(), 0.0);
+    }
+
+    bool RollingCovariance::update(const std::vector<double> &returns)
+    {
+        TRADING_COUNTER_ADD("rolling_covariance.update", 1);
+        checkCrossSection(returns, symbols_);
+
+        const std::size_t n = symbols_;
+        double *c = m2_.data();
+
+        if (count_ < window_)
+        {
+            // Warm-up: Welford add, M2 += (k - 1) / k * a a^T with a = x - mean.
+            std::copy(returns.begin(), returns.end(), ring_.begin() + static_cast<std::ptrdiff_t>(count_ * n));
+            ++count_;
+            const double k = static_cast<double>(count_);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                added_[i] = returns[i] - mean_[i];
+                mean_[i] += added_[i] / k;
+            }
+
+            const double factor = (k - 1.0) / k;
+            const double *a = added_.data();
+            forEachUpperRow(n, pool_, [&](std::size_t i)
+            {
+                const double ai = factor * a[i];
+                double *row = c + i * n;
+                for (std::size_t j = i; j < n; ++j)
+                {
+                    row[j] += ai * a[j];
+                }
+            });
+            return ready();
+        }
+
+        // Replace the oldest observation y by x in one pass:
+        // M2 += a a^T - b b^T - d d^T / k, with a = x - mean, b = y - mean,
+        // d = x - y (all against the old mean) and k the window length.
+        double *oldest = ring_.data() + head_ * n;
+        const double k = static_cast<double>(window_);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            added_[i] = returns[i] - mean_[i];
+            removed_[i] = oldest[i] - mean_[i];
+            diff_[i] = returns[i] - oldest[i];
+            mean_[i] += diff_[i] / k;
+            oldest[i] = returns[i];
+        }
+        head_ = (head_ + 1) % window_;
+
+        const double *a = added_.data();
+        const double *b = removed_.data();
+        const double *d = diff_.data();
+        forEachUpperRow(n, pool_, [&](std::size_t i)
+        {
+            const double ai = a[i];
+            const double bi = b[i];
+            const double di = d[i] / k;
+            double *row = c + i * n;
+            for (std::size_t j = i; j < n; ++j)
+            {
+                row[j] += ai * a[j] - bi * b[j] - di * d[j];
+            }
+        });
+
+        if (++evictions_ >= window_)
+        {
+            recompute();
+        }
+        return true;
+    }
+
+    void RollingCovariance::recompute()
+    {
+        // Exact two-pass recomputation over the window, run once per window_
+        // evictions so rounding error from the rank updates cannot accumulate.
+        TRADING_TRACE_SCOPE("RollingCovariance::recompute");
+
+        const std::size_t n = symbols_;
+        std::fill(mean_.begin(), mean_.end(), 0.0);
+        for (std::size_t t = 0; t < window_; ++t)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                mean_[i] += ring_[t * n + i];
+            }
+        }
+        for (double &m : mean_)
+        {
+            m /= static_cast<double>(window_);
+        }
+
+        std::vector<double> centred(ring_.size());
+        for (std::size_t t = 0; t < window_; ++t)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                centred[t * n + i] = ring_[t * n + i] - mean_[i];
+            }
+        }
+        upperCrossProducts(centred.data(), window_, n, m2_.data(), pool_);
+        evictions_ = 0;
+    }
+
+    SymmetricMatrix RollingCovariance::covariance() const
+    {
+        if (!ready())
+        {
+            throw std::logic_error("RollingCovariance window is not full yet");
+        }
+        return fromUpper(m2_, symbols_, 1.0 / static_cast<double>(window_ - 1));
+    }
+
+    SymmetricMatrix RollingCovariance::correlation() const
+    {
+        return correlation_from_covariance(covariance());
+    }
+
+} // namespace trading
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "core/thread_pool.h"
+#include "core/timestamp.h"
+
+namespace trading
+{
+
+    // Dense symmetric matrix, row-major with both triangles filled.
+    struct SymmetricMatrix
+    {
+        std::size_t size = 0;
+        std::vector<double> values; // size * size
+
+        double operator()(std::size_t i, std::size_t j) const { return values[i * size + j]; }
+    };
+
+    // Sample covariance (n - 1 denominator) of per-period return series.
+    // series[s] holds the returns of symbol s; all series must have the same
+    // length >= 2. Only the upper triangle is computed, in cache-sized tiles
+    // spread over up to `threads` threads (0 = all cores), then mirrored.
+    SymmetricMatrix covariance_matrix(const std::vector<std::vector<double>> &series, std::size_t threads = 0);
+
+    // Pearson correlation of the same series.
+    SymmetricMatrix correlation_matrix(const std::vector<std::vector<double>> &series, std::size_t threads = 0);
+
+    // Correlation from a covariance matrix. Rows and columns of zero-variance
+    // symbols are NaN (the diagonal stays 1).
+    SymmetricMatrix correlation_from_covariance(const SymmetricMatrix &covariance);
+
+    // Exponentially weighted covariance with the TimeWeightedMovingAverage decay:
+    // each observation decays the previous state by u = exp(-dt / T), where dt is
+    // the time since the previous update in days and T the time constant.
+    // Each update() is one O(symbols^2 / 2) pass over the upper triangle. Large
+    // universes split that pass into row chunks on a ThreadPool that lives as
+    // long as the engine (or is passed in), so no thread is created per bar.
+    class EwmaCovariance
+    {
+    public:
+        // threads: 0 = all cores; small universes always update on the calling thread.
+        explicit EwmaCovariance(std::size_t symbols, double timeConstantDays = 5.0, std::size_t threads = 0);
+
+        // Runs large updates on pool, which must outlive the engine.
+        EwmaCovariance(std::size_t symbols, double timeConstantDays, ThreadPool &pool);
+
+        // Reset internal state
+        void reset();
+
+        // Add one cross-section of returns (returns.size() == symbols()).
+        // Timestamps going backwards are treated as a zero gap, as in TWMA.
+        void update(EpochSeconds timestamp, const std::vector<double> &returns);
+
+        bool hasValue() const noexcept { return initialized_; }
+
+        // Exponentially weighted mean of each symbol's returns.
+        const std::vector<double> &mean() const noexcept { return mean_; }
+
+        // Current matrices (throw if no update has been made yet).
+        SymmetricMatrix covariance() const;
+        SymmetricMatrix correlation() const;
+
+        std::size_t symbols() const noexcept { return symbols_; }
+
+    private:
+        EwmaCovariance(std::size_t symbols, double timeConstantDays, ThreadPool *pool, std::size_t threads);
+
+        std::size_t symbols_;
+        double timeConstantDays_;
+        std::unique_ptr<ThreadPool> ownedPool_;
+        ThreadPool *pool_ = nullptr; // null: update on the calling thread
+        bool initialized_ = false;
+        EpochSeconds lastTimestamp_ = 0;
+        std::vector<double> mean_;
+        std::vector<double> upper_; // row-major, only j >= i maintained
+        std::vector<double> delta_;
+    };
+
+    // Sample covariance of the last `window` cross-sections of returns.
+    // Each update() adds the newest and removes the oldest observation with
+    // one fused rank-update of the upper triangle, instead of recomputing the
+    // window. An exact recomputation every `window` evictions bounds the
+    // rounding drift.
+    class RollingCovariance
+    {
+    public:
+        // window must be >= 2; threads and pool as in EwmaCovariance.
+        RollingCovariance(std::size_t symbols, std::size_t window, std::size_t threads = 0);
+        RollingCovariance(std::size_t symbols, std::size_t window, ThreadPool &pool);
+
+        // Reset internal state
+        void reset();
+
+        // Add one cross-section (returns.size() == symbols()).
+        // Returns true once the window is full and covariance() is available.
+        bool update(const std::vector<double> &returns);
+
+        bool ready() const noexcept { return count_ >= window_; }
+
+        // Matrices of the current window (throw if the window is not full yet).
+        SymmetricMatrix covariance() const;
+        SymmetricMatrix correlation() const;
+
+        std::size_t symbols() const noexcept { return symbols_; }
+        std::size_t window() const noexcept { return window_; }
+
+    private:
+        RollingCovariance(std::size_t symbols, std::size_t window, ThreadPool *pool, std::size_t threads);
+
+        void recompute();
+
+        std::size_t symbols_;
+        std::size_t window_;
+        std::unique_ptr<ThreadPool> ownedPool_;
+        ThreadPool *pool_ = nullptr;
+
+        // Ring buffer of the last window_ cross-sections, time-major.
+        std::vector<double> ring_;
+        std::size_t head_ = 0; // row of the oldest cross-section
+        std::size_t count_ = 0;
+        std::size_t evictions_ = 0; // since the last exact recomputation
+
+        std::vector<double> mean_;
+        std::vector<double> m2_; // co-moment sums, row-major, only j >= i maintained
+        std::vector<double> added_;
+        std::vector<double> removed_;
+        std::vector<double> diff_;
+    };
+
+} // namespace trading
@@ -1,39 +1,32 @@
 #include "metrics/drawdown.h"
 
-#include <algorithm>
 #include <stdexcept>
 
+#include "core/instrumentation.h"
+#include "metrics/mixed_precision.h"
+
 namespace trading
 {
-    double max_drawdown(const std::vector<double>& equity)
+    double max_drawdown(const std::vector<double>& equity, InputCheck check)
     {
+        TRADING_TRACE_SCOPE("max_drawdown");
+
         if (equity.size() < 2)
         {
             throw std::invalid_argument("equity vector must contain at least two values");
         }
 
-        const double first = equity.front();
-        if (first <= 0.0)
+        if (check == InputCheck::Checked)
         {
-            throw std::invalid_argument("equity values must be > 0");
-        }
-
-        double peak = first;
-        double max_dd = 0.0;
-
-        // Maximum drawdown is computed over the running peak.
-        for (double e : equity)
-        {
-            if (e <= 0.0)
+            for (double e : equity)
             {
-                throw std::invalid_argument("equity values must be > 0");
+                if (e <= 0.0)
+                {
+                    throw std::invalid_argument("equity values must be > 0");
+                }
             }
-
-            peak = std::max(peak, e);
-            const double dd = (peak - e) / peak; // in [0, 1)
-            max_dd = std::max(max_dd, dd);
         }
 
-        return max_dd;
+        return max_drawdown_of(equity);
     }
 } // namespace trading
\ No newline at end of file
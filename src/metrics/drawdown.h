@@ -2,7 +2,11 @@
 
 #include <vector>
 
+#include "core/input_check.h"
+
 namespace trading
 {
-    double max_drawdown(const std::vector<double>& equity);
+    // Largest peak-to-trough decline of an equity curve, as a fraction of the peak.
+    // InputCheck::Unchecked skips the per-value equity > 0 check.
+    double max_drawdown(const std::vector<double>& equity, InputCheck check = InputCheck::Checked);
 } // namespace trading
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "metrics/mixed_precision.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "core/instrumentation.h"
+
+namespace trading
+{
+    namespace
+    {
+        constexpr EpochSeconds kSecondsPerDay = 86400;
+
+        EpochSeconds dayNumber(EpochSeconds t)
+        {
+            const EpochSeconds q = t / kSecondsPerDay;
+            return (t % kSecondsPerDay < 0) ? q - 1 : q;
+        }
+    } // namespace
+
+    template <SeriesValue T>
+    PriceSeries<T> toPriceSeries(const BarColumns &columns)
+    {
+        PriceSeries<T> series;
+        series.timestamps = columns.timestamps;
+        series.close.assign(columns.close.begin(), columns.close.end());
+        series.volume.assign(columns.volume.begin(), columns.volume.end());
+        return series;
+    }
+
+    template <SeriesValue T>
+    std::vector<T> twma_series(const std::vector<EpochSeconds> &timestamps,
+                               const std::vector<T> &closes,
+                               double time_constant_days)
+    {
+        TRADING_TRACE_SCOPE("twma_series");
+
+        if (time_constant_days <= 0.0)
+        {
+            throw std::invalid_argument("Invalid argument: time_constant_days must be > 0");
+        }
+        if (timestamps.size() != closes.size())
+        {
+            throw std::invalid_argument("timestamps and closes must have the same length");
+        }
+        TRADING_COUNTER_ADD("twma.bars", closes.size());
+
+        std::vector<T> out(closes.size());
+        if (closes.empty())
+        {
+            return out;
+        }
+
+        double ema = closes[0];
+        EpochSeconds lastDay = dayNumber(timestamps[0]);
+        out[0] = static_cast<T>(ema);
+        for (std::size_t i = 1; i < closes.size(); ++i)
+        {
+            const EpochSeconds day = dayNumber(timestamps[i]);
+            const double deltaDays = std::max(0.0, static_cast<double>(day - lastDay));
+            lastDay = day;
+
+            ema = twma_step(ema, static_cast<double>(closes[i]), deltaDays, time_constant_days);
+            out[i] = static_cast<T>(ema);
+        }
+        return out;
+    }
+
+    template <SeriesValue T>
+    std::vector<T> vwma_series(const std::vector<T> &closes, const std::vector<T> &volumes, std::size_t window)
+    {
+        TRADING_TRACE_SCOPE("vwma_series");
+
+        if (window == 0 || closes.size() < window)
+        {
+            throw std::invalid_argument("Invalid argument: windowSize must be > 0 and <= number of bars");
+        }
+        if (closes.size() != volumes.size())
+        {
+            throw std::invalid_argument("closes and volumes must have the same length");
+        }
+        TRADING_COUNTER_ADD("vwma.bars", closes.size());
+
+        std::vector<T> out(closes.size(), std::numeric_limits<T>::quiet_NaN());
+        double sumPriceVolume = 0.0;
+        double sumVolume = 0.0;
+        for (std::size_t i = 0; i < closes.size(); ++i)
+        {
+            // A float x float product is exact in double.
+            sumPriceVolume += static_cast<double>(closes[i]) * static_cast<double>(volumes[i]);
+            sumVolume += static_cast<double>(volumes[i]);
+            if (i >= window)
+            {
+                const std::size_t old = i - window;
+                sumPriceVolume -= static_cast<double>(closes[old]) * static_cast<double>(volumes[old]);
+                sumVolume -= static_cast<double>(volumes[old]);
+            }
+            if (i + 1 >= window)
+            {
+                out[i] = static_cast<T>((sumVolume > 0.0) ? (sumPriceVolume / sumVolume) : 0.0);
+            }
+        }
+        return out;
+    }
+
+    template <SeriesValue T>
+    std::vector<T> equity_curve(const std::vector<T> &closes, double starting_equity)
+    {
+        TRADING_TRACE_SCOPE("equity_curve");
+
+        if (starting_equity <= 0.0)
+        {
+            throw std::invalid_argument("starting_equity must be > 0");
+        }
+        if (closes.empty())
+        {
+            throw std::invalid_argument("bars must not be empty");
+        }
+
+        std::vector<T> out(closes.size());
+        double equity = starting_equity;
+        out[0] = static_cast<T>(equity);
+        for (std::size_t i = 1; i < closes.size(); ++i)
+        {
+            equity *= static_cast<double>(closes[i]) / static_cast<double>(closes[i - 1]);
+            out[i] = static_cast<T>(equity);
+        }
+        return out;
+    }
+
+    template <SeriesValue T>
+    double max_drawdown_of(const std::vector<T> &equity)
+    {
+        TRADING_TRACE_SCOPE("max_drawdown_of");
+
+        if (equity.size() < 2)
+        {
+            throw std::invalid_argument("equity vector must contain at least two values");
+        }
+
+        double peak = equity.front();
+        double max_dd = 0.0;
+        for (T value : equity)
+        {
+            const double e = value;
+            peak = std::max(peak, e);
+            max_dd = std::max(max_dd, (peak - e) / peak);
+        }
+        return max_dd;
+    }
+
+    template <SeriesValue T>
+    ReturnMetrics return_metrics_of(const std::vector<T> &equity, int periods_per_year)
+    {
+        TRADING_TRACE_SCOPE("return_metrics_of");
+
+        if (equity.size() < 2)
+        {
+            throw std::invalid_argument("equity vector must contain at least two values");
+        }
+        const double starting_value = equity.front();
+        if (starting_value == 0.0)
+        {
+            throw std::invalid_argument("equity start value cannot be zero");
+        }
+
+        double sum_log_returns = 0.0;
+        for (std::size_t i = 1; i < equity.size(); ++i)
+        {
+            const double r = (static_cast<double>(equity[i]) / static_cast<double>(equity[i - 1])) - 1.0;
+            sum_log_returns += std::log1p(r);
+        }
+
+        const int ppy = ReturnCalculator(periods_per_year).periods_per_year();
+        ReturnMetrics metrics;
+        metrics.cumulative_return = (static_cast<double>(equity.back()) / starting_value) - 1.0;
+        metrics.avg_period_return = sum_log_returns / static_cast<double>(equity.size() - 1);
+        metrics.annualized_return = std::expm1(metrics.avg_period_return * static_cast<double>(ppy));
+        return metrics;
+    }
+
+    template PriceSeries<float> toPriceSeries<float>(const BarColumns &);
+    template PriceSeries<double> toPriceSeries<double>(const BarColumns &);
+    template std::vector<float> twma_series<float>(const std::vector<EpochSeconds> &, const std::vector<float> &, double);
+    template std::vector<double> twma_series<double>(const std::vector<EpochSeconds> &, const std::vector<double> &, double);
+    template std::vector<float> vwma_series<float>(const std::vector<float> &, const std::vector<float> &, std::size_t);
+    template std::vector<double> vwma_series<double>(const std::vector<double> &, const std::vector<double> &, std::size_t);
+    template std::vector<float> equity_curve<float>(const std::vector<float> &, double);
+    template std::vector<double> equity_curve<double>(const std::vector<double> &, double);
+    template double max_drawdown_of<float>(const std::vector<float> &);
+    template double max_drawdown_of<double>(const std::vector<double> &);
+    template ReturnMetrics return_metrics_of<float>(const std::vector<float> &, int);
+    template ReturnMetrics return_metrics_of<double>(const std::vector<double> &, int);
+
+} // namespace trading
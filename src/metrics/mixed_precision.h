@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <vector>
+
+#include "core/bar_columns.h"
+#include "core/timestamp.h"
+#include "metrics/return_metrics.h"
+
+namespace trading
+{
+
+    // Storage types the kernels below are instantiated for. Whatever the
+    // storage type, every kernel accumulates in double; float storage halves
+    // the memory traffic of large sweeps and only rounds values when they are
+    // loaded and stored.
+    template <typename T>
+    concept SeriesValue = std::same_as<T, float> || std::same_as<T, double>;
+
+    // Close/volume columns of a bar series in storage type T.
+    template <SeriesValue T>
+    struct PriceSeries
+    {
+        std::vector<EpochSeconds> timestamps;
+        std::vector<T> close;
+        std::vector<T> volume;
+
+        std::size_t size() const noexcept { return close.size(); }
+    };
+
+    template <SeriesValue T>
+    PriceSeries<T> toPriceSeries(const BarColumns &columns);
+
+    // Error bounds of the float instantiations against the double ones, for
+    // positive prices/volumes and with u = 2^-24 (float unit roundoff) and n
+    // the series length. TimeWeightedMovingAverage::compute,
+    // VolumeWeightedMovingAverage::compute, calculate_equity_curve_from_bars,
+    // max_drawdown and ReturnCalculator::from_equity validate their input and
+    // then run the double instantiations.
+    //
+    //   twma_series        relative 2u (a convex combination of rounded inputs, rounded once)
+    //   vwma_series        relative 4u, plus the running-sum cancellation both share
+    //   equity_curve       relative 3u + n * 2^-53 (price ratios telescope, so errors do not compound)
+    //   max_drawdown_of    absolute 2e, with e the relative error of the equity input
+    //   return_metrics_of  cumulative_return absolute 2e * (1 + cumulative_return),
+    //                      avg_period_return absolute 2e / (n - 1)
+
+    // One TWMA step: ema_n = u * ema_{n-1} + (1 - u) * x_n with u = e^{-dt / T}.
+    // Shared with TimeWeightedMovingAverage::update.
+    inline double twma_step(double ema, double close, double delta_days, double time_constant_days)
+    {
+        const double u = std::exp(-(delta_days / time_constant_days));
+        return u * ema + (1.0 - u) * close;
+    }
+
+    // TWMA of closes with the TimeWeightedMovingAverage decay; gaps are whole
+    // calendar days between timestamps.
+    template <SeriesValue T>
+    std::vector<T> twma_series(const std::vector<EpochSeconds> &timestamps,
+                               const std::vector<T> &closes,
+                               double time_constant_days);
+
+    // VWMA over a fixed window; the first window - 1 entries are NaN.
+    template <SeriesValue T>
+    std::vector<T> vwma_series(const std::vector<T> &closes, const std::vector<T> &volumes, std::size_t window);
+
+    // Buy-and-hold equity, equity[i] = equity[i-1] * closes[i] / closes[i-1].
+    template <SeriesValue T>
+    std::vector<T> equity_curve(const std::vector<T> &closes, double starting_equity = 1.0);
+
+    // max_drawdown / ReturnCalculator::from_equity over stored equity,
+    // without the per-element input checks.
+    template <SeriesValue T>
+    double max_drawdown_of(const std::vector<T> &equity);
+
+    template <SeriesValue T>
+    ReturnMetrics return_metrics_of(const std::vector<T> &equity, int periods_per_year = 245);
+
+} // namespace trading
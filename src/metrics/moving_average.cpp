@@ -1,11 +1,15 @@
 #include "metrics/moving_average.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <stdexcept>
 #include <string>
 #include <chrono>
 
+#include "core/instrumentation.h"
+#include "metrics/mixed_precision.h"
+
 namespace trading
 {
 
@@ -42,24 +46,9 @@ namespace trading
         auto delta = currentDate - lastDate_;
         lastDate_ = currentDate;
 
-        double deltaDays = static_cast<double>(delta);
-        if (deltaDays < 0.0)
-        {
-            // If dates go backwards, treat as 0 gap (or you could throw)
-            deltaDays = 0.0;
-        }
-
-        // a = (t_n - t_{n-1}) / T
-        const double a = deltaDays / timeConstantDays_;
-
-        // u = e^{-a}
-        const double u = std::exp(-a);
-
-        // x_n = bar.close
-        const double xN = bar.close;
-
-        // ema_n = u * ema_{n-1} + (1 - u) * x_n
-        ema_ = u * ema_ + (1.0 - u) * xN;
+        // If dates go backwards, treat as 0 gap
+        const double deltaDays = std::max(0.0, static_cast<double>(delta));
+        ema_ = twma_step(ema_, bar.close, deltaDays, timeConstantDays_);
 
         return ema_;
     }
@@ -102,23 +91,24 @@ namespace trading
         return static_cast<SysDays>(sd.time_since_epoch().count());
     }
 
-     std::vector<double> TimeWeightedMovingAverage::compute(const std::vector<Bar> &bars, std::size_t windowSize) {
+    std::vector<double> TimeWeightedMovingAverage::compute(const std::vector<Bar> &bars, std::size_t windowSize)
+    {
+        TRADING_TRACE_SCOPE("TimeWeightedMovingAverage::compute");
+
         if (bars.empty())
         {
             throw std::invalid_argument("Data vector is empty");
         }
 
-        TimeWeightedMovingAverage twma(windowSize);
-        std::vector<double> result;
-        result.reserve(bars.size());
-
-        for (const auto &bar : bars)
+        // Midnight of each bar's date; twma_series only looks at whole days.
+        std::vector<EpochSeconds> timestamps(bars.size());
+        std::vector<double> closes(bars.size());
+        for (std::size_t i = 0; i < bars.size(); ++i)
         {
-            double current = twma.update(bar);
-            result.push_back(current);
+            timestamps[i] = static_cast<EpochSeconds>(parseYyyyMmDd(bars[i].date)) * 86400;
+            closes[i] = bars[i].close;
         }
-
-        return result;
+        return twma_series(timestamps, closes, static_cast<double>(windowSize));
     }
 
     VolumeWeightedMovingAverage::VolumeWeightedMovingAverage(std::size_t windowSize)
@@ -169,30 +159,21 @@ namespace trading
 
     std::vector<double> VolumeWeightedMovingAverage::compute(const std::vector<Bar> &bars, std::size_t windowSize)
     {
+        TRADING_TRACE_SCOPE("VolumeWeightedMovingAverage::compute");
+
         if (windowSize == 0 || bars.size() < windowSize)
         {
             throw std::invalid_argument("Invalid argument: windowSize must be > 0 and <= number of bars");
         }
 
-        VolumeWeightedMovingAverage vwma(windowSize);
-        std::vector<double> result;
-        result.reserve(bars.size());
-
+        std::vector<double> closes(bars.size());
+        std::vector<double> volumes(bars.size());
         for (std::size_t i = 0; i < bars.size(); ++i)
         {
-            double current = vwma.update(bars[i]);
-            if (i + 1 < windowSize)
-            {
-                // Window not full yet; indicate missing value
-                result.push_back(std::numeric_limits<double>::quiet_NaN());
-            }
-            else
-            {
-                result.push_back(current);
-            }
+            closes[i] = bars[i].close;
+            volumes[i] = bars[i].volume;
         }
-
-        return result;
+        return vwma_series(closes, volumes, windowSize);
     }
 
 } // namespace trading
@@ -33,6 +33,8 @@ namespace trading
         static std::vector<double> compute(const std::vector<Bar> &bars, std::size_t windowSize);
 
     private:
+        friend struct SnapshotAccess; // data/snapshot.cpp
+
         // Convert "YYYYMMDD" → sys_days using JDN
         static SysDays parseYyyyMmDd(const std::string &s);
 
@@ -64,6 +66,8 @@ namespace trading
         static std::vector<double> compute(const std::vector<Bar> &bars, std::size_t windowSize);
 
     private:
+        friend struct SnapshotAccess; // data/snapshot.cpp
+
         std::size_t windowSize_;
         std::size_t count_;
         std::deque<double> priceVolumeProducts_;
@@ -3,6 +3,9 @@
 #include <stdexcept>
 #include <cmath>
 
+#include "core/instrumentation.h"
+#include "metrics/mixed_precision.h"
+
 namespace trading
 {
 
@@ -16,8 +19,10 @@ namespace trading
         return (periods_per_year > 0) ? periods_per_year : 245;
     }
 
-    ReturnMetrics ReturnCalculator::from_equity(const std::vector<double> &equity) const
+    ReturnMetrics ReturnCalculator::from_equity(const std::vector<double> &equity, InputCheck check) const
     {
+        TRADING_TRACE_SCOPE("ReturnCalculator::from_equity");
+
         if (equity.size() < 2)
         {
             throw std::invalid_argument("equity vector must contain at least two values");
@@ -29,32 +34,24 @@ namespace trading
             throw std::invalid_argument("equity start value cannot be zero");
         }
 
-        double sum_log_returns = 0.0;
-        std::size_t count = 0;
-
-        for (std::size_t i = 1; i < equity.size(); ++i)
+        if (check == InputCheck::Checked)
         {
-            const double prev = equity[i - 1];
-            if (prev == 0.0)
+            for (std::size_t i = 1; i + 1 < equity.size(); ++i)
             {
-                throw std::invalid_argument("equity values cannot contain zero (division by zero)");
+                if (equity[i] == 0.0)
+                {
+                    throw std::invalid_argument("equity values cannot contain zero (division by zero)");
+                }
             }
-
-            const double r = (equity[i] / prev) - 1.0;
-            sum_log_returns += std::log1p(r);
-            ++count;
         }
 
-        ReturnMetrics metrics;
-        metrics.cumulative_return = (equity.back() / starting_value) - 1.0;
-        metrics.avg_period_return = (count > 0) ? (sum_log_returns / static_cast<double>(count)) : 0.0;
-        metrics.annualized_return = std::expm1(metrics.avg_period_return * static_cast<double>(periods_per_year_));
-
-        return metrics;
+        return return_metrics_of(equity, periods_per_year_);
     }
 
     ReturnMetrics ReturnCalculator::from_returns(const std::vector<double> &returns) const
     {
+        TRADING_TRACE_SCOPE("ReturnCalculator::from_returns");
+
         if (returns.empty())
         {
             throw std::invalid_argument("returns vector must not be empty");
@@ -2,6 +2,8 @@
 
 #include <vector>
 
+#include "core/input_check.h"
+
 namespace trading
 {
 
@@ -20,7 +22,8 @@ namespace trading
         explicit ReturnCalculator(int periods_per_year = 245);
 
         // Compute return metrics from an equity curve (portfolio value per bar).
-        ReturnMetrics from_equity(const std::vector<double> &equity) const;
+        // InputCheck::Unchecked skips the per-value zero check.
+        ReturnMetrics from_equity(const std::vector<double> &equity, InputCheck check = InputCheck::Checked) const;
 
         // Compute return metrics directly from a vector of per-period arithmetic returns.
         ReturnMetrics from_returns(const std::vector<double> &returns) const;
@@ -0,0 +1,221 @@
+#include "metrics/rolling_metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "core/instrumentation.h"
+#include "metrics/return_metrics.h"
+
+namespace trading
+{
+
+    RollingWindowMetrics::RollingWindowMetrics(std::size_t window, int periods_per_year)
+        : window_(window),
+          periods_per_year_(ReturnCalculator(periods_per_year).periods_per_year())
+    {
+        if (window_ < 3)
+        {
+            throw std::invalid_argument("Invalid argument: window must be >= 3");
+        }
+        ring_.resize(window_);
+        front_.reserve(window_);
+        back_.reserve(window_);
+    }
+
+    void RollingWindowMetrics::reset()
+    {
+        head_ = 0;
+        count_ = 0;
+        evictions_ = 0;
+        returnCount_ = 0;
+        mean_ = 0.0;
+        m2_ = 0.0;
+        front_.clear();
+        back_.clear();
+        backSummary_ = DrawdownSummary{};
+    }
+
+    RollingWindowMetrics::DrawdownSummary
+    RollingWindowMetrics::combine(const DrawdownSummary &older, const DrawdownSummary &newer)
+    {
+        // Worst peak-to-trough drop is inside either half, or from the older
+        // half's peak to the newer half's trough.
+        const double across = (older.max - newer.min) / older.max;
+        return DrawdownSummary{
+            std::max(older.max, newer.max),
+            std::min(older.min, newer.min),
+            std::max({older.drawdown, newer.drawdown, across})};
+    }
+
+    void RollingWindowMetrics::addReturn(double r)
+    {
+        ++returnCount_;
+        const double delta = r - mean_;
+        mean_ += delta / static_cast<double>(returnCount_);
+        m2_ += delta * (r - mean_);
+    }
+
+    void RollingWindowMetrics::removeReturn(double r)
+    {
+        --returnCount_;
+        if (returnCount_ == 0)
+        {
+            mean_ = 0.0;
+            m2_ = 0.0;
+            return;
+        }
+        const double delta = r - mean_;
+        mean_ -= delta / static_cast<double>(returnCount_);
+        m2_ -= delta * (r - mean_);
+    }
+
+    void RollingWindowMetrics::recomputeMoments()
+    {
+        // Two-pass recomputation over the window, run once per window_ evictions
+        // so rounding error from add/remove cannot accumulate.
+        double sum = 0.0;
+        for (std::size_t k = 1; k < count_; ++k)
+        {
+            sum += ring_[(head_ + k) % window_] / ring_[(head_ + k - 1) % window_] - 1.0;
+        }
+        returnCount_ = count_ - 1;
+        mean_ = (returnCount_ > 0) ? sum / static_cast<double>(returnCount_) : 0.0;
+
+        m2_ = 0.0;
+        for (std::size_t k = 1; k < count_; ++k)
+        {
+            const double r = ring_[(head_ + k) % window_] / ring_[(head_ + k - 1) % window_] - 1.0;
+            m2_ += (r - mean_) * (r - mean_);
+        }
+    }
+
+    void RollingWindowMetrics::popOldestDrawdown()
+    {
+        if (front_.empty())
+        {
+            // Move the back stack over, newest first, building suffix summaries.
+            while (!back_.empty())
+            {
+                const double e = back_.back();
+                back_.pop_back();
+                const DrawdownSummary leaf{e, e, 0.0};
+                front_.push_back(front_.empty() ? leaf : combine(leaf, front_.back()));
+            }
+            backSummary_ = DrawdownSummary{};
+        }
+        front_.pop_back();
+    }
+
+    bool RollingWindowMetrics::update(double equity)
+    {
+        if (equity <= 0.0)
+        {
+            throw std::invalid_argument("equity values must be > 0");
+        }
+
+        if (count_ == window_)
+        {
+            const double oldest = ring_[head_];
+            const double next = ring_[(head_ + 1) % window_];
+            removeReturn(next / oldest - 1.0);
+            popOldestDrawdown();
+            head_ = (head_ + 1) % window_;
+            --count_;
+            ++evictions_;
+        }
+
+        if (count_ > 0)
+        {
+            const double prev = ring_[(head_ + count_ - 1) % window_];
+            addReturn(equity / prev - 1.0);
+        }
+        ring_[(head_ + count_) % window_] = equity;
+        ++count_;
+
+        if (evictions_ == window_)
+        {
+            evictions_ = 0;
+            recomputeMoments();
+        }
+
+        const DrawdownSummary leaf{equity, equity, 0.0};
+        backSummary_ = back_.empty() ? leaf : combine(backSummary_, leaf);
+        back_.push_back(equity);
+
+        return ready();
+    }
+
+    RollingMetricsValue RollingWindowMetrics::value() const
+    {
+        if (!ready())
+        {
+            throw std::logic_error("RollingWindowMetrics window is not full yet");
+        }
+
+        DrawdownSummary total;
+        if (front_.empty())
+        {
+            total = backSummary_;
+        }
+        else if (back_.empty())
+        {
+            total = front_.back();
+        }
+        else
+        {
+            total = combine(front_.back(), backSummary_);
+        }
+
+        const double first = ring_[head_];
+        const double last = ring_[(head_ + count_ - 1) % window_];
+        const double ppy = static_cast<double>(periods_per_year_);
+
+        const double variance = std::max(m2_, 0.0) / static_cast<double>(returnCount_ - 1);
+        const double stdev = std::sqrt(variance);
+
+        RollingMetricsValue v;
+        v.cumulative_return = last / first - 1.0;
+        v.annualized_return = std::expm1(std::log(last / first) / static_cast<double>(returnCount_) * ppy);
+        v.volatility = stdev * std::sqrt(ppy);
+        v.sharpe = (stdev > 0.0) ? (mean_ / stdev) * std::sqrt(ppy) : std::numeric_limits<double>::quiet_NaN();
+        v.max_drawdown = total.drawdown;
+        return v;
+    }
+
+    RollingMetricsSeries compute_rolling_metrics(
+        const std::vector<double> &equity,
+        std::size_t window,
+        int periods_per_year)
+    {
+        TRADING_TRACE_SCOPE("compute_rolling_metrics");
+
+        RollingWindowMetrics rolling(window, periods_per_year);
+
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        RollingMetricsSeries series;
+        series.cumulative_return.assign(equity.size(), nan);
+        series.annualized_return.assign(equity.size(), nan);
+        series.volatility.assign(equity.size(), nan);
+        series.sharpe.assign(equity.size(), nan);
+        series.max_drawdown.assign(equity.size(), nan);
+
+        for (std::size_t i = 0; i < equity.size(); ++i)
+        {
+            if (!rolling.update(equity[i]))
+            {
+                continue;
+            }
+            const RollingMetricsValue v = rolling.value();
+            series.cumulative_return[i] = v.cumulative_return;
+            series.annualized_return[i] = v.annualized_return;
+            series.volatility[i] = v.volatility;
+            series.sharpe[i] = v.sharpe;
+            series.max_drawdown[i] = v.max_drawdown;
+        }
+
+        return series;
+    }
+
+} // namespace trading
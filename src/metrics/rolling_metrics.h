@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace trading
+{
+
+    // Metrics of the most recent `window` equity values.
+    struct RollingMetricsValue
+    {
+        double cumulative_return = 0.0; // last / first - 1 within the window
+        double annualized_return = 0.0; // same definition as ReturnCalculator::from_equity
+        double volatility = 0.0;        // sample stdev of per-period returns * sqrt(periods_per_year)
+        double sharpe = 0.0;            // mean / stdev * sqrt(periods_per_year), risk-free rate 0
+        double max_drawdown = 0.0;      // same definition as max_drawdown()
+    };
+
+    // Sliding-window return, volatility, Sharpe and max drawdown over an equity curve.
+    // Each update() costs amortized O(1) regardless of the window length:
+    // return moments are maintained incrementally and the drawdown uses a
+    // two-stack queue of (max, min, drawdown) summaries.
+    class RollingWindowMetrics
+    {
+    public:
+        // window is the number of equity values (window - 1 returns); must be >= 3.
+        explicit RollingWindowMetrics(std::size_t window, int periods_per_year = 245);
+
+        // Reset internal state
+        void reset();
+
+        // Push the next equity value (must be > 0).
+        // Returns true once the window is full and value() is available.
+        bool update(double equity);
+
+        bool ready() const noexcept { return count_ >= window_; }
+
+        // Metrics of the current window (throws if the window is not full yet).
+        // sharpe is NaN when all returns in the window are identical.
+        RollingMetricsValue value() const;
+
+        std::size_t window() const noexcept { return window_; }
+        int periods_per_year() const noexcept { return periods_per_year_; }
+
+    private:
+        friend struct SnapshotAccess; // data/snapshot.cpp
+
+        struct DrawdownSummary
+        {
+            double max;
+            double min;
+            double drawdown;
+        };
+
+        static DrawdownSummary combine(const DrawdownSummary &older, const DrawdownSummary &newer);
+
+        void addReturn(double r);
+        void removeReturn(double r);
+        void recomputeMoments();
+        void popOldestDrawdown();
+
+        std::size_t window_;
+        int periods_per_year_;
+
+        // Ring buffer of the last window_ equity values.
+        std::vector<double> ring_;
+        std::size_t head_ = 0; // index of the oldest value
+        std::size_t count_ = 0;
+        std::size_t evictions_ = 0; // since the last exact recomputation of the moments
+
+        // Running moments of the returns inside the window.
+        std::size_t returnCount_ = 0;
+        double mean_ = 0.0;
+        double m2_ = 0.0;
+
+        // Two-stack queue: front_ holds the oldest values with suffix summaries,
+        // back_ holds the newest values and backSummary_ aggregates them.
+        std::vector<DrawdownSummary> front_;
+        std::vector<double> back_;
+        DrawdownSummary backSummary_{};
+    };
+
+    // Per-bar rolling metrics. Every vector has equity.size() entries; the first
+    // (window - 1) entries are NaN because the window is not yet full.
+    struct RollingMetricsSeries
+    {
+        std::vector<double> cumulative_return;
+        std::vector<double> annualized_return;
+        std::vector<double> volatility;
+        std::vector<double> sharpe;
+        std::vector<double> max_drawdown;
+    };
+
+    RollingMetricsSeries compute_rolling_metrics(
+        const std::vector<double> &equity,
+        std::size_t window,
+        int periods_per_year = 245);
+
+} // namespace trading
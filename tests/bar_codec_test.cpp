@@ -0,0 +1,105 @@
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include "core/bar.h"
+#include "core/timestamp.h"
+#include "data/bar_codec.h"
+#include "data/csv_loader.h"
+
+using trading::Bar;
+using trading::BarField;
+using trading::CompressedBarSeries;
+
+namespace
+{
+    bool sameBar(const Bar &a, const Bar &b)
+    {
+        return a.symbol == b.symbol && a.period == b.period && a.date == b.date && a.time == b.time &&
+               a.open == b.open && a.high == b.high && a.low == b.low && a.close == b.close &&
+               a.volume == b.volume && a.openInterest == b.openInterest;
+    }
+
+    // Two symbols of one-minute bars with tick-sized fractional prices.
+    std::vector<Bar> makeMinuteBars(std::size_t count)
+    {
+        std::vector<Bar> bars;
+        bars.reserve(count);
+        const trading::EpochSeconds start = trading::toEpochSeconds("20240105", "090000");
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto t = start + static_cast<trading::EpochSeconds>((i / 2) * 60 + (i / 600) * 3600);
+            const double px = 1500.0 + static_cast<double>((i * 7) % 40) * 0.5;
+            bars.push_back(Bar{
+                (i % 2 == 0) ? "7203.JP" : "6758.JP",
+                "1",
+                trading::formatDate(t),
+                trading::formatTime(t),
+                px,
+                px + 1.5,
+                px - 1.0,
+                px + 0.5,
+                static_cast<double>(100 * (i % 97)),
+                0});
+        }
+        return bars;
+    }
+}
+
+int main()
+{
+    // --- Round trip of the JPX fixture ------------------------------------
+    const auto fixture = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+    const auto bars = trading::loadBarsFromCsv(fixture);
+
+    const auto encoded = CompressedBarSeries::encode(bars, 128);
+    assert(encoded.size() == bars.size());
+    assert(encoded.blockCount() == (bars.size() + 127) / 128);
+    assert(encoded.symbols().size() == 1);
+
+    const auto decoded = encoded.decodeBars();
+    assert(decoded.size() == bars.size());
+    for (std::size_t i = 0; i < bars.size(); ++i)
+    {
+        assert(sameBar(decoded[i], bars[i]));
+    }
+
+    // --- Decode a single field straight into a double array ---------------
+    std::vector<double> close(encoded.blockSize(1));
+    encoded.decodeField(1, BarField::Close, close.data());
+    for (std::size_t i = 0; i < close.size(); ++i)
+    {
+        assert(close[i] == bars[encoded.blockOffset(1) + i].close);
+    }
+
+    // --- Minute bars: fractional prices, two symbols, session gaps --------
+    const auto minuteBars = makeMinuteBars(10000);
+    const auto minuteEncoded = CompressedBarSeries::encode(minuteBars);
+    const auto minuteDecoded = minuteEncoded.decodeBars();
+    assert(minuteDecoded.size() == minuteBars.size());
+    for (std::size_t i = 0; i < minuteBars.size(); ++i)
+    {
+        assert(sameBar(minuteDecoded[i], minuteBars[i]));
+    }
+
+    const auto columns = minuteEncoded.decodeColumns();
+    assert(columns.size() == minuteBars.size());
+    assert(columns.timestamps[2] - columns.timestamps[0] == 60);
+
+    const std::size_t rawBytes = minuteBars.size() * (5 * sizeof(double) + sizeof(std::uint64_t) + sizeof(trading::EpochSeconds));
+    std::cout << "minute bars: " << rawBytes << " raw bytes -> " << minuteEncoded.compressedBytes() << " encoded\n";
+    assert(minuteEncoded.compressedBytes() * 5 < rawBytes);
+
+    // --- Prices without an exact decimal scale fall back to raw doubles ---
+    std::vector<Bar> irrational = {
+        {"X", "D", "20240101", "000000", 1.0 / 3.0, 1.0, 0.1, 2.0 / 3.0, 1.0, 0},
+        {"X", "D", "20240102", "000000", 3.14159265358979, 4.0, 0.2, 1e-300, 2.0, 0},
+    };
+    const auto irrationalDecoded = CompressedBarSeries::encode(irrational).decodeBars();
+    assert(sameBar(irrationalDecoded[0], irrational[0]));
+    assert(sameBar(irrationalDecoded[1], irrational[1]));
+
+    std::cout << "bar_codec_test passed\n";
+    return 0;
+}
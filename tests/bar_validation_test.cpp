@@ -0,0 +1,111 @@
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "core/bar.h"
+#include "data/bar_validation.h"
+#include "data/csv_loader.h"
+#include "metrics/calculate_equity_curve.h"
+#include "metrics/drawdown.h"
+#include "metrics/return_metrics.h"
+
+using trading::Bar;
+using trading::BarIssue;
+using trading::InputCheck;
+
+int main()
+{
+    // --- One bar per issue ---------------------------------------------------
+    std::vector<Bar> bars = {
+        {"X", "D", "20240101", "000000", 10.0, 11.0, 9.0, 10.0, 100.0, 0},  // 0 ok
+        {"X", "D", "20240102", "000000", 10.0, 11.0, 9.0, 0.0, 100.0, 0},   // 1 non-positive close
+        {"X", "D", "20240103", "000000", 10.0, 9.0, 11.0, 10.0, 100.0, 0},  // 2 high < low
+        {"X", "D", "20240103", "000000", 10.0, 11.0, 9.0, 10.0, 100.0, 0},  // 3 duplicate
+        {"X", "D", "20240102", "000000", 10.0, 11.0, 9.0, 10.0, 100.0, 0},  // 4 out of order
+        {"X", "D", "20240104", "000000", 10.0, 11.0, 9.0, 10.0, 0.0, 0},    // 5 zero volume
+        {"X", "D", "2024-01-05", "000000", 10.0, 11.0, 9.0, 10.0, 100.0, 0}, // 6 bad timestamp
+        {"X", "D", "20240105", "000000", 10.0, 11.0, 9.0, 10.0, 100.0, 0},  // 7 ok
+        {"X", "D", "20240301", "000000", 10.0, 11.0, 9.0, 10.0, 100.0, 0},  // 8 gap
+        {"Y", "D", "20240101", "000000", 10.0, 11.0, 9.0, 10.0, 100.0, 0},  // 9 new symbol run: ok
+    };
+
+    const auto report = trading::validateBars(bars);
+    assert(report.flags.size() == bars.size());
+    assert(!report.flags[0].any());
+    assert(report.flags[1] == BarIssue::NonPositiveClose);
+    assert(report.flags[2] == BarIssue::HighBelowLow);
+    assert(report.flags[3] == BarIssue::DuplicateTimestamp);
+    assert(report.flags[4] == BarIssue::OutOfOrder);
+    assert(report.flags[5] == BarIssue::ZeroVolume);
+    assert(report.flags[6] == BarIssue::BadTimestamp);
+    assert(!report.flags[7].any());
+    assert(report.flags[8] == BarIssue::GapBefore);
+    assert(!report.flags[9].any());
+    assert(report.maxGapSeconds == 5 * 2 * 86400); // median spacing of parsed neighbours is 2 days
+    assert(report.count(BarIssue::OutOfOrder) == 1);
+    assert((report.flags[3] | BarIssue::ZeroVolume).has(BarIssue::DuplicateTimestamp));
+    assert(report.dropped == 5);
+    std::cout << report.summary();
+
+    const auto cleaned = trading::cleanBars(bars);
+    assert(cleaned.bars.size() == bars.size() - 5);
+    assert(cleaned.bars[1].volume == 0.0); // zero volume kept by default
+
+    trading::ValidationOptions strict;
+    strict.dropMask = trading::BarIssues::all();
+    strict.maxGapSeconds = 86400 * 30;
+    const auto strictReport = trading::validateBars(bars, strict);
+    assert(strictReport.flags[8] == BarIssue::GapBefore);
+    assert(strictReport.dropped == 7);
+
+    // A NaN high or low cannot be ordered, so it counts as high < low.
+    std::vector<Bar> nanBars = {bars[0], bars[0], bars[0]};
+    nanBars[1].date = "20240102";
+    nanBars[1].high = std::nan("");
+    nanBars[2].date = "20240103";
+    nanBars[2].low = std::nan("");
+    const auto nanReport = trading::validateBars(nanBars);
+    assert(!nanReport.flags[0].any());
+    assert(nanReport.flags[1] == BarIssue::HighBelowLow);
+    assert(nanReport.flags[2] == BarIssue::HighBelowLow);
+    assert(nanReport.dropped == 2);
+
+    // --- Columns path matches the bar path on a clean single-symbol series --
+    const auto fixture = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+    const auto fixtureBars = trading::loadBarsFromCsv(fixture);
+    const auto barReport = trading::validateBars(fixtureBars);
+    const auto columnReport = trading::validateColumns(trading::toColumns(fixtureBars));
+    assert(barReport.flags == columnReport.flags);
+    assert(barReport.dropped == 0);
+
+    // --- Unchecked kernels agree with checked ones on validated data --------
+    const auto fixtureClean = trading::cleanBars(fixtureBars);
+    const auto checkedEquity = trading::calculate_equity_curve_from_bars(fixtureClean.bars, 100.0);
+    const auto fastEquity = trading::calculate_equity_curve_from_bars(fixtureClean.bars, 100.0, InputCheck::Unchecked);
+    assert(checkedEquity == fastEquity);
+    assert(trading::max_drawdown(checkedEquity) == trading::max_drawdown(fastEquity, InputCheck::Unchecked));
+
+    const trading::ReturnCalculator calc;
+    const auto m1 = calc.from_equity(checkedEquity);
+    const auto m2 = calc.from_equity(fastEquity, InputCheck::Unchecked);
+    assert(m1.annualized_return == m2.annualized_return);
+    assert(m1.cumulative_return == m2.cumulative_return);
+
+    // Checked mode still rejects bad input.
+    bool threw = false;
+    try
+    {
+        trading::calculate_equity_curve_from_bars(bars, 100.0);
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "bar_validation_test passed\n";
+    return 0;
+}
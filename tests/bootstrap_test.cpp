@@ -0,0 +1,114 @@
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "data/csv_loader.h"
+#include "metrics/bootstrap.h"
+#include "metrics/calculate_equity_curve.h"
+#include "metrics/return_metrics.h"
+
+using trading::BootstrapConfig;
+using trading::BootstrapMethod;
+
+int main()
+{
+    // --- Counter-based RNG is a pure function of (seed, stream, counter) ---
+    trading::CounterRng a(42, 7);
+    trading::CounterRng b(42, 7);
+    trading::CounterRng c(42, 8);
+    const auto a0 = a.next();
+    assert(a0 == b.next());
+    assert(a0 != c.next());
+    for (int i = 0; i < 1000; ++i)
+    {
+        const double u = a.uniform();
+        assert(u >= 0.0 && u < 1.0);
+        assert(b.below(10) < 10);
+    }
+
+    // --- sample_quantile ----------------------------------------------------
+    assert(trading::sample_quantile({3.0, 1.0, 2.0, NAN}, 0.5) == 2.0);
+    assert(trading::sample_quantile({0.0, 10.0}, 0.25) == 2.5);
+
+    // --- Constant returns: every path is identical --------------------------
+    BootstrapConfig config;
+    config.paths = 100;
+    config.method = BootstrapMethod::Iid;
+    const std::vector<double> flat(50, 0.01);
+    const auto flatDist = trading::bootstrap_returns(flat, config);
+    const trading::ReturnCalculator calc;
+    const double expected = calc.from_returns(flat).annualized_return;
+    for (std::size_t p = 0; p < config.paths; ++p)
+    {
+        assert(std::fabs(flatDist.annualized_return[p] - expected) <= 1e-9 * std::fabs(expected));
+        assert(flatDist.max_drawdown[p] == 0.0);
+    }
+
+    // --- Block lengths outside [1, returns] are rejected ---------------------
+    for (double bad : {0.0, 0.5, 51.0, static_cast<double>(NAN)})
+    {
+        for (auto method : {BootstrapMethod::Block, BootstrapMethod::Stationary})
+        {
+            BootstrapConfig blocky = config;
+            blocky.method = method;
+            blocky.block_length = bad;
+            bool threw = false;
+            try
+            {
+                trading::bootstrap_returns(flat, blocky);
+            }
+            catch (const std::invalid_argument &)
+            {
+                threw = true;
+            }
+            assert(threw);
+        }
+    }
+    BootstrapConfig whole = config;
+    whole.method = BootstrapMethod::Block;
+    whole.block_length = 50.0;
+    assert(trading::bootstrap_returns(flat, whole).max_drawdown.size() == config.paths);
+
+    // --- Fixture returns: all methods, reproducible across thread counts ----
+    const auto fixture = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+    const auto equity = trading::calculate_equity_curve_from_csv(fixture, 1.0);
+    std::vector<double> returns;
+    for (std::size_t i = 1; i < equity.size(); ++i)
+    {
+        returns.push_back(equity[i] / equity[i - 1] - 1.0);
+    }
+
+    for (BootstrapMethod method : {BootstrapMethod::Iid, BootstrapMethod::Block, BootstrapMethod::Stationary})
+    {
+        BootstrapConfig cfg;
+        cfg.method = method;
+        cfg.paths = 2000;
+        cfg.block_length = 10.0;
+        cfg.seed = 12345;
+        cfg.threads = 1;
+        const auto serial = trading::bootstrap_returns(returns, cfg);
+        cfg.threads = 4;
+        const auto parallel = trading::bootstrap_returns(returns, cfg);
+
+        assert(serial.annualized_return == parallel.annualized_return);
+        assert(serial.max_drawdown == parallel.max_drawdown);
+        for (std::size_t p = 0; p < cfg.paths; ++p)
+        {
+            assert(parallel.max_drawdown[p] >= 0.0 && parallel.max_drawdown[p] < 1.0);
+        }
+
+        // Resampling preserves the mean log-return, so the median annualized
+        // return sits near the point estimate (in log space).
+        const double point = std::log1p(calc.from_returns(returns).annualized_return);
+        const double median = std::log1p(trading::sample_quantile(parallel.annualized_return, 0.5));
+        std::cout << "method " << static_cast<int>(method) << ": median log annualized " << median
+                  << " vs point " << point << "\n";
+        assert(std::fabs(median - point) < 0.25 * std::fabs(point) + 0.5);
+    }
+
+    std::cout << "bootstrap_test passed\n";
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "core/bar.h"
+#include "core/thread_pool.h"
+#include "core/timestamp.h"
+#include "metrics/covariance.h"
+#include "metrics/moving_average.h"
+
+using trading::SymmetricMatrix;
+
+namespace
+{
+    // Deterministic pseudo-random returns in [-0.05, 0.05).
+    std::vector<std::vector<double>> makeSeries(std::size_t symbols, std::size_t length, std::uint64_t seed)
+    {
+        std::vector<std::vector<double>> series(symbols, std::vector<double>(length));
+        std::uint64_t state = seed;
+        for (auto &s : series)
+        {
+            for (double &r : s)
+            {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                r = (static_cast<double>(state >> 11) / 9007199254740992.0 - 0.5) * 0.1;
+            }
+        }
+        return series;
+    }
+
+    double naiveCovariance(const std::vector<double> &a, const std::vector<double> &b,
+                           std::size_t begin, std::size_t end)
+    {
+        double ma = 0.0;
+        double mb = 0.0;
+        for (std::size_t t = begin; t < end; ++t)
+        {
+            ma += a[t];
+            mb += b[t];
+        }
+        const double n = static_cast<double>(end - begin);
+        ma /= n;
+        mb /= n;
+        double sum = 0.0;
+        for (std::size_t t = begin; t < end; ++t)
+        {
+            sum += (a[t] - ma) * (b[t] - mb);
+        }
+        return sum / (n - 1.0);
+    }
+
+    bool near(double a, double b, double tol = 1e-12)
+    {
+        return std::fabs(a - b) <= tol;
+    }
+}
+
+int main()
+{
+    // --- Full sample matches a naive double loop across tile boundaries -------
+    const auto series = makeSeries(70, 40, 7);
+    const SymmetricMatrix cov = trading::covariance_matrix(series, 1);
+    assert(cov.size == 70);
+    for (std::size_t i = 0; i < 70; ++i)
+    {
+        for (std::size_t j = 0; j < 70; ++j)
+        {
+            assert(near(cov(i, j), naiveCovariance(series[i], series[j], 0, 40)));
+            assert(cov(i, j) == cov(j, i));
+        }
+    }
+
+    // Threaded tiles give bit-identical results to the serial pass.
+    const auto wide = makeSeries(300, 20, 11);
+    assert(trading::covariance_matrix(wide, 1).values == trading::covariance_matrix(wide, 3).values);
+
+    // Perfectly (anti-)correlated and constant series.
+    std::vector<std::vector<double>> linked = {series[0], series[0], series[0], std::vector<double>(40, 0.5)};
+    for (std::size_t t = 0; t < 40; ++t)
+    {
+        linked[1][t] = 3.0 * series[0][t] + 0.01;
+        linked[2][t] = -series[0][t];
+    }
+    const SymmetricMatrix corr = trading::correlation_matrix(linked);
+    assert(near(corr(0, 1), 1.0) && near(corr(0, 2), -1.0));
+    assert(corr(3, 3) == 1.0 && std::isnan(corr(0, 3)));
+
+    bool threw = false;
+    try
+    {
+        trading::covariance_matrix({{0.1, 0.2}, {0.1}});
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    // --- EWMA uses the TWMA decay ------------------------------------------------
+    const double timeConstant = 4.0;
+    trading::EwmaCovariance ewma(2, timeConstant);
+    trading::TimeWeightedMovingAverage twma(timeConstant);
+    const char *dates[] = {"20240102", "20240103", "20240104", "20240108", "20240109", "20240115"};
+    for (std::size_t t = 0; t < 6; ++t)
+    {
+        const double r = series[0][t];
+        ewma.update(trading::toEpochSeconds(dates[t], "000000"), {r, 3.0 * r + 0.01});
+        const double expectedMean = twma.update(trading::Bar{"X", "D", dates[t], "000000", r, r, r, r, 1.0, 0});
+        assert(near(ewma.mean()[0], expectedMean));
+    }
+    const SymmetricMatrix ewmaCov = ewma.covariance();
+    assert(ewmaCov(0, 0) > 0.0);
+    assert(near(ewmaCov(1, 1), 9.0 * ewmaCov(0, 0)));
+    assert(near(ewmaCov(0, 1), 3.0 * ewmaCov(0, 0)));
+    assert(near(ewma.correlation()(0, 1), 1.0));
+
+    // A repeated observation one day later only decays the state by u.
+    const double before = ewma.covariance()(0, 0);
+    const std::vector<double> atMean = ewma.mean();
+    ewma.update(trading::toEpochSeconds("20240116", "000000"), atMean);
+    assert(near(ewma.covariance()(0, 0), before * std::exp(-1.0 / timeConstant)));
+
+    // --- Rolling window matches a fresh computation per window -----------------
+    const std::size_t window = 8;
+    const auto stream = makeSeries(5, 40, 23);
+    trading::RollingCovariance rolling(5, window);
+    for (std::size_t t = 0; t < 40; ++t)
+    {
+        std::vector<double> crossSection(5);
+        for (std::size_t s = 0; s < 5; ++s)
+        {
+            crossSection[s] = stream[s][t];
+        }
+        const bool ready = rolling.update(crossSection);
+        assert(ready == (t + 1 >= window));
+        if (!ready)
+        {
+            continue;
+        }
+        const SymmetricMatrix m = rolling.covariance();
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            for (std::size_t j = 0; j < 5; ++j)
+            {
+                assert(near(m(i, j), naiveCovariance(stream[i], stream[j], t + 1 - window, t + 1), 1e-15));
+            }
+        }
+    }
+
+    // --- Pooled updates match the calling-thread updates bit for bit ----------
+    const std::size_t big = 300; // above the parallel threshold
+    const auto bigStream = makeSeries(big, 12, 31);
+    trading::ThreadPool pool(3);
+    trading::EwmaCovariance ewmaSerial(big, timeConstant, 1);
+    trading::EwmaCovariance ewmaPooled(big, timeConstant, pool);
+    trading::RollingCovariance rollingSerial(big, 4, 1);
+    trading::RollingCovariance rollingPooled(big, 4, pool);
+    trading::RollingCovariance rollingOwned(big, 4, 2);
+    for (std::size_t t = 0; t < 12; ++t)
+    {
+        std::vector<double> crossSection(big);
+        for (std::size_t s = 0; s < big; ++s)
+        {
+            crossSection[s] = bigStream[s][t];
+        }
+        const auto timestamp = static_cast<trading::EpochSeconds>(t) * 86400;
+        ewmaSerial.update(timestamp, crossSection);
+        ewmaPooled.update(timestamp, crossSection);
+        rollingSerial.update(crossSection);
+        rollingPooled.update(crossSection);
+        rollingOwned.update(crossSection);
+    }
+    assert(ewmaSerial.covariance().values == ewmaPooled.covariance().values);
+    assert(rollingSerial.covariance().values == rollingPooled.covariance().values);
+    assert(rollingSerial.covariance().values == rollingOwned.covariance().values);
+
+    std::cout << "covariance_test passed\n";
+    return 0;
+}
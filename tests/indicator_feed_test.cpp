@@ -0,0 +1,228 @@
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "data/csv_loader.h"
+#include "data/indicator_feed.h"
+
+using trading::IndicatorPublisher;
+using trading::IndicatorReader;
+using trading::IndicatorValues;
+
+namespace
+{
+    bool same(double a, double b)
+    {
+        return a == b || (std::isnan(a) && std::isnan(b));
+    }
+}
+
+int main()
+{
+    const std::string name = "/trading_feed_test_" + std::to_string(getpid());
+
+    bool threw = false;
+    try
+    {
+        IndicatorReader missing(name);
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    {
+        IndicatorPublisher publisher(name, 5);
+        IndicatorReader reader(name);
+
+        // --- Slots ------------------------------------------------------------------
+        const std::size_t slot = publisher.addSymbol("130A.JP");
+        assert(slot == 0);
+        assert(publisher.addSymbol("130A.JP") == 0);
+        assert(reader.symbolCount() == 1);
+        assert(reader.symbol(0) == "130A.JP");
+        assert(reader.findSymbol("130A.JP") == 0u);
+        assert(!reader.findSymbol("OTHER").has_value());
+        assert(!reader.read(0).has_value());
+
+        threw = false;
+        try
+        {
+            publisher.addSymbol(std::string(40, 'X'));
+        }
+        catch (const std::length_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+
+        // --- Indicator engine publishes every bar ------------------------------------
+        const auto fixture = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+        const auto bars = trading::loadBarsFromCsv(fixture);
+        trading::PublishedIndicators indicators(publisher, bars.front().symbol, 5.0, 10, 20);
+        for (const auto &bar : bars)
+        {
+            indicators.update(bar);
+        }
+
+        const auto seen = reader.read(indicators.slot());
+        assert(seen.has_value());
+        const IndicatorValues &latest = indicators.latest();
+        assert(seen->timestamp == latest.timestamp);
+        assert(same(seen->close, latest.close));
+        assert(same(seen->twma, latest.twma));
+        assert(same(seen->vwma, latest.vwma));
+        assert(same(seen->sharpe, latest.sharpe));
+        assert(same(seen->maxDrawdown, latest.maxDrawdown));
+        assert(!std::isnan(seen->maxDrawdown));
+        assert(seen->updates == bars.size());
+        assert(reader.updates(indicators.slot()) == bars.size());
+        assert(seen->publishedNs > 0);
+        assert(latest.updates == bars.size() && latest.publishedNs == seen->publishedNs);
+
+        // --- Rejected bars leave the indicators untouched ----------------------------
+        trading::PublishedIndicators control(publisher, "CONTROL", 5.0, 10, 20);
+        trading::PublishedIndicators probe(publisher, "PROBE", 5.0, 10, 20);
+        for (std::size_t i = 0; i + 1 < bars.size(); ++i)
+        {
+            control.update(bars[i]);
+            probe.update(bars[i]);
+        }
+        const IndicatorValues before = probe.latest();
+        trading::Bar badClose = bars.back();
+        badClose.close = 0.0;
+        trading::Bar badDate = bars.back();
+        badDate.date = "2024-1-1";
+        for (const trading::Bar &bad : {badClose, badDate})
+        {
+            threw = false;
+            try
+            {
+                probe.update(bad);
+            }
+            catch (const std::invalid_argument &)
+            {
+                threw = true;
+            }
+            assert(threw);
+            assert(probe.latest().updates == before.updates && probe.latest().timestamp == before.timestamp);
+        }
+        const IndicatorValues &a = control.update(bars.back());
+        const IndicatorValues &b = probe.update(bars.back());
+        assert(same(a.twma, b.twma) && same(a.vwma, b.vwma) && same(a.sharpe, b.sharpe));
+        assert(same(a.maxDrawdown, b.maxDrawdown) && a.updates == b.updates);
+
+        // --- A writer that dies mid-publish does not hang readers --------------------
+        {
+            // White-box: a 64-byte header precedes slot 0, whose first word is its sequence.
+            const int fd = shm_open(name.c_str(), O_RDWR, 0);
+            assert(fd >= 0);
+            void *mapped = mmap(nullptr, 128, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            assert(mapped != MAP_FAILED);
+            auto *sequence = reinterpret_cast<std::atomic<std::uint64_t> *>(static_cast<char *>(mapped) + 64);
+            const std::uint64_t saved = sequence->load();
+            sequence->store(saved + 1); // odd: write in progress forever
+
+            threw = false;
+            try
+            {
+                reader.read(indicators.slot());
+            }
+            catch (const std::runtime_error &)
+            {
+                threw = true;
+            }
+            assert(threw);
+            sequence->store(saved);
+            munmap(mapped, 128);
+            assert(reader.read(indicators.slot()).has_value());
+        }
+
+        // --- Readers never observe a torn write --------------------------------------
+        const std::size_t hot = publisher.addSymbol("HOT");
+        constexpr int kWrites = 200000;
+        std::atomic<bool> done{false};
+        std::thread writer([&]
+        {
+            for (int k = 1; k <= kWrites; ++k)
+            {
+                const double v = k;
+                IndicatorValues values;
+                values.timestamp = k;
+                values.close = values.twma = values.vwma = v;
+                values.cumulativeReturn = values.volatility = values.sharpe = values.maxDrawdown = v;
+                publisher.publish(hot, values);
+            }
+            done = true;
+        });
+
+        std::uint64_t lastUpdates = 0;
+        std::size_t reads = 0;
+        while (!done.load() || lastUpdates < kWrites)
+        {
+            const auto v = reader.read(hot);
+            if (!v)
+            {
+                continue;
+            }
+            const double k = static_cast<double>(v->timestamp);
+            assert(v->close == k && v->twma == k && v->vwma == k && v->maxDrawdown == k);
+            assert(v->updates == static_cast<std::uint64_t>(v->timestamp));
+            assert(v->updates >= lastUpdates);
+            lastUpdates = v->updates;
+            ++reads;
+        }
+        writer.join();
+        assert(lastUpdates == kWrites);
+        assert(reads > 0);
+    }
+
+    // The publisher unlinks the region on destruction.
+    threw = false;
+    try
+    {
+        IndicatorReader gone(name);
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    // --- A live region is not taken over unless asked --------------------------------
+    {
+        auto first = std::make_unique<IndicatorPublisher>(name, 1);
+        threw = false;
+        try
+        {
+            IndicatorPublisher second(name, 1);
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+        IndicatorReader stillFirst(name); // the failed attempt left the region alone
+
+        IndicatorPublisher recovered(name, 2, trading::ExistingRegion::Replace);
+        first.reset(); // must not unlink the replacement
+        IndicatorReader reader(name);
+        recovered.addSymbol("NEW");
+        assert(reader.symbolCount() == 1);
+    }
+
+    std::cout << "indicator_feed_test passed\n";
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/instrumentation.h"
+#include "data/csv_loader.h"
+#include "metrics/calculate_equity_curve.h"
+#include "metrics/drawdown.h"
+
+namespace instr = trading::instrumentation;
+
+namespace
+{
+    void tracedWork(int iterations)
+    {
+        for (int i = 0; i < iterations; ++i)
+        {
+            TRADING_TRACE_SCOPE("test.work");
+            TRADING_COUNTER_ADD("test.items", 2);
+        }
+    }
+}
+
+int main()
+{
+    instr::reset();
+
+    // --- Library probes around the loader and metric kernels --------------
+    const auto fixture = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+    const auto bars = trading::loadBarsFromCsv(fixture);
+    const auto equity = trading::calculate_equity_curve_from_bars(bars, 100000.0);
+    (void)trading::max_drawdown(equity);
+
+    // --- Probes recorded from several threads -----------------------------
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 3; ++t)
+    {
+        workers.emplace_back(tracedWork, 100);
+    }
+    for (auto &w : workers)
+    {
+        w.join();
+    }
+    tracedWork(100);
+
+    std::ostringstream summary;
+    instr::writeSummary(summary);
+    std::cout << summary.str();
+
+    std::ostringstream trace;
+    instr::writeChromeTrace(trace);
+    const std::string json = trace.str();
+
+#if TRADING_INSTRUMENTATION
+    const std::string text = summary.str();
+    assert(text.find("loadBarsFromCsv") != std::string::npos);
+    assert(text.find("max_drawdown") != std::string::npos);
+    assert(text.find("total=440") != std::string::npos);  // csv.rows: one per fixture row
+    assert(text.find("test.work") != std::string::npos);
+    assert(text.find("total=800") != std::string::npos);  // 4 threads x 100 x 2 items
+
+    assert(json.rfind("{\"displayTimeUnit\"", 0) == 0);
+    assert(json.find("\"name\":\"test.work\",\"ph\":\"X\"") != std::string::npos);
+    assert(json.find("\"name\":\"csv.rows\",\"ph\":\"C\"") != std::string::npos);
+
+    // reset() clears counters and events.
+    instr::reset();
+    std::ostringstream cleared;
+    instr::writeChromeTrace(cleared);
+    assert(cleared.str().find("\"ph\":\"X\"") == std::string::npos);
+
+    // Exited threads hand their state to the next thread and keep their counts.
+    const std::size_t states = instr::threadStateCount();
+    for (int t = 0; t < 50; ++t)
+    {
+        std::thread(tracedWork, 1).join();
+    }
+    assert(instr::threadStateCount() == states);
+    std::ostringstream pooled;
+    instr::writeSummary(pooled);
+    assert(pooled.str().find("total=100") != std::string::npos);
+
+    // ... but each of those threads still gets its own trace tid.
+    std::ostringstream pooledTrace;
+    instr::writeChromeTrace(pooledTrace);
+    const std::string events = pooledTrace.str();
+    const std::string marker = "\"name\":\"test.work\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+    std::set<std::string> tids;
+    for (auto at = events.find(marker); at != std::string::npos; at = events.find(marker, at + 1))
+    {
+        const auto begin = at + marker.size();
+        tids.insert(events.substr(begin, events.find(',', begin) - begin));
+    }
+    assert(tids.size() == 50);
+#else
+    assert(json.find("\"ph\":\"X\"") == std::string::npos);
+#endif
+
+    std::cout << "instrumentation_test passed\n";
+    return 0;
+}
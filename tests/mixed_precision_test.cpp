@@ -0,0 +1,127 @@
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "core/bar_columns.h"
+#include "data/csv_loader.h"
+#include "metrics/calculate_equity_curve.h"
+#include "metrics/drawdown.h"
+#include "metrics/mixed_precision.h"
+#include "metrics/moving_average.h"
+#include "metrics/return_metrics.h"
+
+namespace
+{
+    constexpr double kU = 5.9604644775390625e-08; // 2^-24
+
+    bool sameBits(const std::vector<double> &a, const std::vector<double> &b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            if (!(a[i] == b[i] || (std::isnan(a[i]) && std::isnan(b[i]))))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // max_i |f_i - d_i| / |d_i| over non-NaN entries.
+    double maxRelativeError(const std::vector<float> &f, const std::vector<double> &d)
+    {
+        double worst = 0.0;
+        for (std::size_t i = 0; i < d.size(); ++i)
+        {
+            if (std::isnan(d[i]))
+            {
+                assert(std::isnan(f[i]));
+                continue;
+            }
+            worst = std::max(worst, std::fabs(static_cast<double>(f[i]) - d[i]) / std::fabs(d[i]));
+        }
+        return worst;
+    }
+}
+
+int main()
+{
+    const auto fixture = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+    const auto bars = trading::loadBarsFromCsv(fixture);
+    const auto columns = trading::toColumns(bars);
+    const auto f64 = trading::toPriceSeries<double>(columns);
+    const auto f32 = trading::toPriceSeries<float>(columns);
+    const double n = static_cast<double>(bars.size());
+    const trading::ReturnCalculator calc;
+
+    // --- The double entry points run the double instantiations -------------------
+    const auto twma = trading::twma_series(f64.timestamps, f64.close, 5.0);
+    const auto vwma = trading::vwma_series(f64.close, f64.volume, 20);
+    const auto equity = trading::equity_curve(f64.close, 100.0);
+    assert(sameBits(twma, trading::TimeWeightedMovingAverage::compute(bars, 5)));
+    assert(sameBits(vwma, trading::VolumeWeightedMovingAverage::compute(bars, 20)));
+    assert(sameBits(equity, trading::calculate_equity_curve_from_bars(bars, 100.0)));
+
+    const double dd = trading::max_drawdown_of(equity);
+    const auto metrics = trading::return_metrics_of(equity);
+    assert(dd == trading::max_drawdown(equity));
+    const auto expected = calc.from_equity(equity);
+    assert(metrics.cumulative_return == expected.cumulative_return);
+    assert(metrics.avg_period_return == expected.avg_period_return);
+    assert(metrics.annualized_return == expected.annualized_return);
+
+    // --- Float storage stays within the documented bounds ------------------------
+    const auto twma32 = trading::twma_series(f32.timestamps, f32.close, 5.0);
+    const auto vwma32 = trading::vwma_series(f32.close, f32.volume, 20);
+    const auto equity32 = trading::equity_curve(f32.close, 100.0);
+
+    const double twmaError = maxRelativeError(twma32, twma);
+    const double vwmaError = maxRelativeError(vwma32, vwma);
+    const double equityError = maxRelativeError(equity32, equity);
+    assert(twmaError <= 2.0 * kU);
+    assert(vwmaError <= 4.0 * kU + 1e-12);
+    const double e = 3.0 * kU + n * 0x1p-53;
+    assert(equityError <= e);
+
+    const double dd32 = trading::max_drawdown_of(equity32);
+    assert(std::fabs(dd32 - dd) <= 2.0 * e);
+
+    const auto metrics32 = trading::return_metrics_of(equity32);
+    assert(std::fabs(metrics32.cumulative_return - metrics.cumulative_return) <=
+           2.0 * e * (1.0 + metrics.cumulative_return));
+    assert(std::fabs(metrics32.avg_period_return - metrics.avg_period_return) <= 2.0 * e / (n - 1.0) + 1e-15);
+
+    // --- Input validation ---------------------------------------------------------
+    const auto throws = [](auto &&fn)
+    {
+        try
+        {
+            fn();
+        }
+        catch (const std::invalid_argument &)
+        {
+            return true;
+        }
+        return false;
+    };
+    const std::vector<float> one = {1.0f};
+    assert(throws([&] { trading::twma_series(f32.timestamps, f32.close, 0.0); }));
+    assert(throws([&] { trading::twma_series(f32.timestamps, one, 5.0); }));
+    assert(throws([&] { trading::vwma_series(f32.close, f32.volume, 0); }));
+    assert(throws([&] { trading::vwma_series(f32.close, one, 1); }));
+    assert(throws([&] { trading::equity_curve(f32.close, 0.0); }));
+    assert(throws([&] { trading::equity_curve(std::vector<float>{}, 1.0); }));
+    assert(throws([&] { trading::max_drawdown_of(one); }));
+    assert(throws([&] { trading::return_metrics_of(std::vector<float>{0.0f, 1.0f}); }));
+
+    std::cout << "max relative error twma " << twmaError / kU << "u, vwma " << vwmaError / kU
+              << "u, equity " << equityError / kU << "u\n";
+    std::cout << "mixed_precision_test passed\n";
+    return 0;
+}
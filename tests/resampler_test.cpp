@@ -0,0 +1,165 @@
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "core/bar.h"
+#include "core/timestamp.h"
+#include "data/csv_loader.h"
+#include "data/resampler.h"
+#include "metrics/calculate_equity_curve.h"
+#include "metrics/moving_average.h"
+
+using trading::Bar;
+using trading::BarResampler;
+using trading::ResamplePeriod;
+
+namespace
+{
+    // One-minute bars from 09:00 for `count` minutes; close = minute index + 100.
+    std::vector<Bar> makeMinuteBars(const std::string &symbol, const std::string &date, int count)
+    {
+        std::vector<Bar> bars;
+        const auto start = trading::toEpochSeconds(date, "090000");
+        for (int i = 0; i < count; ++i)
+        {
+            const auto t = start + i * 60;
+            const double px = 100.0 + i;
+            bars.push_back(Bar{symbol, "1", trading::formatDate(t), trading::formatTime(t),
+                               px - 0.5, px + 1.0, px - 1.0, px, 10.0, static_cast<std::uint64_t>(i)});
+        }
+        return bars;
+    }
+
+    bool sameBar(const Bar &a, const Bar &b)
+    {
+        return a.symbol == b.symbol && a.period == b.period && a.date == b.date && a.time == b.time &&
+               a.open == b.open && a.high == b.high && a.low == b.low && a.close == b.close &&
+               a.volume == b.volume && a.openInterest == b.openInterest;
+    }
+
+    template <typename Fn>
+    bool throwsInvalid(Fn &&fn)
+    {
+        try
+        {
+            fn();
+        }
+        catch (const std::invalid_argument &)
+        {
+            return true;
+        }
+        return false;
+    }
+}
+
+int main()
+{
+    // --- Period codes -------------------------------------------------------
+    assert(ResamplePeriod::fromCode("5").lengthSeconds() == 300);
+    assert(ResamplePeriod::fromCode("60").code() == "60");
+    assert(ResamplePeriod::hours(1).code() == "60");
+    assert(ResamplePeriod::fromCode("D").code() == "D");
+    // 2024-01-10 is a Wednesday; its week starts Monday 2024-01-08.
+    const auto wed = trading::toEpochSeconds("20240110", "120000");
+    assert(trading::formatDate(ResamplePeriod::weeks().bucketStart(wed)) == "20240108");
+
+    // --- Batch: 1-minute -> 5-minute ----------------------------------------
+    auto minutes = makeMinuteBars("7203.JP", "20240110", 12); // 09:00 .. 09:11
+    const auto fiveMin = trading::resampleBars(minutes, ResamplePeriod::minutes(5));
+    assert(fiveMin.size() == 3);
+    assert(fiveMin[0].time == "090000" && fiveMin[1].time == "090500" && fiveMin[2].time == "091000");
+    assert(fiveMin[0].period == "5");
+    assert(fiveMin[0].open == 99.5);
+    assert(fiveMin[0].high == 105.0);  // max high over 09:00..09:04
+    assert(fiveMin[0].low == 99.0);
+    assert(fiveMin[0].close == 104.0);
+    assert(fiveMin[0].volume == 50.0);
+    assert(fiveMin[0].openInterest == 4);
+    assert(fiveMin[2].volume == 20.0); // partial last bucket
+
+    // --- Streaming matches batch -------------------------------------------
+    BarResampler stream(ResamplePeriod::minutes(5));
+    std::vector<Bar> streamed;
+    for (const auto &bar : minutes)
+    {
+        if (auto done = stream.update(bar))
+        {
+            streamed.push_back(*done);
+        }
+    }
+    if (auto last = stream.flush())
+    {
+        streamed.push_back(*last);
+    }
+    assert(streamed.size() == fiveMin.size());
+    for (std::size_t i = 0; i < streamed.size(); ++i)
+    {
+        assert(sameBar(streamed[i], fiveMin[i]));
+    }
+
+    // --- Multi-symbol, parallel per symbol ----------------------------------
+    const auto a = makeMinuteBars("A", "20240110", 130);
+    const auto b = makeMinuteBars("B", "20240111", 70);
+    std::vector<Bar> mixed;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        mixed.push_back(a[i]);
+        if (i < b.size())
+        {
+            mixed.push_back(b[i]);
+        }
+    }
+    const auto hourly = trading::resampleBySymbol(mixed, ResamplePeriod::hours(1), 2);
+    const auto hourlyA = trading::resampleBars(a, ResamplePeriod::hours(1));
+    const auto hourlyB = trading::resampleBars(b, ResamplePeriod::hours(1));
+    assert(hourly.size() == hourlyA.size() + hourlyB.size());
+    assert(hourlyA.size() == 3 && hourlyB.size() == 2);
+    assert(sameBar(hourly[0], hourlyA[0]));
+    assert(sameBar(hourly.back(), hourlyB.back()));
+
+    // Column resampling rejects mixed symbols instead of merging their bars.
+    assert(throwsInvalid([&] { trading::resampleColumns(trading::toColumns(mixed), ResamplePeriod::hours(1)); }));
+
+    // --- Daily fixture -> weekly, consumed by TWMA/VWMA/equity --------------
+    const auto fixture = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+    const auto daily = trading::loadBarsFromCsv(fixture);
+    const auto weekly = trading::resampleBars(daily, ResamplePeriod::weeks());
+    assert(!weekly.empty() && weekly.size() < daily.size());
+    assert(weekly.front().open == daily.front().open);
+    assert(weekly.back().close == daily.back().close);
+
+    double totalVolume = 0.0;
+    for (const auto &bar : daily)
+    {
+        totalVolume += bar.volume;
+    }
+    double weeklyVolume = 0.0;
+    for (const auto &bar : weekly)
+    {
+        weeklyVolume += bar.volume;
+    }
+    assert(weeklyVolume == totalVolume);
+
+    // A target finer than the source period is rejected.
+    assert(throwsInvalid([&] { trading::resampleBars(daily, ResamplePeriod::hours(1)); }));
+    assert(throwsInvalid([&] { trading::resampleColumns(trading::toColumns(weekly), ResamplePeriod::days()); }));
+    assert(trading::resampleBars(daily, ResamplePeriod::days()).size() == daily.size());
+    trading::BarResampler fiveMinute(ResamplePeriod::minutes(5));
+    assert(throwsInvalid([&] { fiveMinute.update(daily[0]); }));
+    trading::BarResampler streamedWeekly(ResamplePeriod::weeks());
+    assert(!streamedWeekly.update(daily[0]));
+
+    // Hour counts whose minute count does not fit are rejected, not wrapped.
+    assert(ResamplePeriod::hours(24).lengthSeconds() == 86400);
+    assert(throwsInvalid([] { ResamplePeriod::hours(std::numeric_limits<unsigned>::max() / 60 + 1); }));
+
+    assert(trading::TimeWeightedMovingAverage::compute(weekly, 5).size() == weekly.size());
+    assert(trading::VolumeWeightedMovingAverage::compute(weekly, 4).size() == weekly.size());
+    assert(trading::calculate_equity_curve_from_bars(weekly).size() == weekly.size());
+
+    std::cout << "resampler_test passed\n";
+    return 0;
+}
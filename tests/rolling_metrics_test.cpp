@@ -0,0 +1,96 @@
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include "data/csv_loader.h"
+#include "metrics/calculate_equity_curve.h"
+#include "metrics/drawdown.h"
+#include "metrics/return_metrics.h"
+#include "metrics/rolling_metrics.h"
+
+using trading::RollingWindowMetrics;
+
+namespace
+{
+    bool nearlyEqual(double a, double b, double eps = 1e-9)
+    {
+        return std::fabs(a - b) <= eps * std::max(1.0, std::fabs(b));
+    }
+
+    // Reference: existing full-series functions applied to each window.
+    void checkAgainstFullSeries(const std::vector<double> &equity, std::size_t window)
+    {
+        const auto series = trading::compute_rolling_metrics(equity, window);
+        assert(series.max_drawdown.size() == equity.size());
+
+        const trading::ReturnCalculator calc;
+        const double ppy = static_cast<double>(calc.periods_per_year());
+
+        for (std::size_t i = 0; i < equity.size(); ++i)
+        {
+            if (i + 1 < window)
+            {
+                assert(std::isnan(series.max_drawdown[i]));
+                assert(std::isnan(series.volatility[i]));
+                continue;
+            }
+
+            const std::vector<double> slice(equity.begin() + static_cast<std::ptrdiff_t>(i + 1 - window),
+                                            equity.begin() + static_cast<std::ptrdiff_t>(i + 1));
+
+            const auto m = calc.from_equity(slice);
+            assert(nearlyEqual(series.cumulative_return[i], m.cumulative_return));
+            assert(nearlyEqual(series.annualized_return[i], m.annualized_return, 1e-8));
+            assert(nearlyEqual(series.max_drawdown[i], trading::max_drawdown(slice)));
+
+            double mean = 0.0;
+            for (std::size_t k = 1; k < slice.size(); ++k)
+            {
+                mean += slice[k] / slice[k - 1] - 1.0;
+            }
+            mean /= static_cast<double>(slice.size() - 1);
+            double ss = 0.0;
+            for (std::size_t k = 1; k < slice.size(); ++k)
+            {
+                const double d = slice[k] / slice[k - 1] - 1.0 - mean;
+                ss += d * d;
+            }
+            const double stdev = std::sqrt(ss / static_cast<double>(slice.size() - 2));
+            assert(nearlyEqual(series.volatility[i], stdev * std::sqrt(ppy)));
+            assert(nearlyEqual(series.sharpe[i], mean / stdev * std::sqrt(ppy), 1e-7));
+        }
+    }
+}
+
+int main()
+{
+    // --- Streaming form on a small synthetic curve ------------------------
+    RollingWindowMetrics rolling(3);
+    assert(!rolling.update(100.0));
+    assert(!rolling.update(120.0));
+    assert(rolling.update(90.0)); // window [100, 120, 90]
+    assert(nearlyEqual(rolling.value().max_drawdown, 0.25));
+    assert(nearlyEqual(rolling.value().cumulative_return, -0.10));
+
+    rolling.update(95.0); // window [120, 90, 95]
+    assert(nearlyEqual(rolling.value().max_drawdown, 0.25));
+    rolling.update(99.0); // window [90, 95, 99]
+    assert(nearlyEqual(rolling.value().max_drawdown, 0.0));
+
+    rolling.reset();
+    assert(!rolling.ready());
+
+    // --- Batch form against the full-series functions on the fixture ------
+    const auto fixture = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+    const auto equity = trading::calculate_equity_curve_from_csv(fixture, 100000.0);
+
+    for (std::size_t window : {3u, 20u, 60u, 250u})
+    {
+        checkAgainstFullSeries(equity, window);
+    }
+
+    std::cout << "rolling_metrics_test passed\n";
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "backtest/run_journal.h"
+#include "data/csv_loader.h"
+
+using trading::JournalWriter;
+using trading::RunJournal;
+using trading::RunSpec;
+
+int main()
+{
+    const auto dir = std::filesystem::temp_directory_path();
+    const auto path = dir / "trading_run_journal_test.bin";
+
+    RunSpec spec;
+    spec.csvPath = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+    spec.twmaTimeConstantDays = 7.5;
+    spec.vwmaWindow = 15;
+    spec.periodsPerYear = 250;
+    spec.startingEquity = 100.0;
+
+    // --- Record a run ------------------------------------------------------------
+    RunJournal executed;
+    {
+        JournalWriter journal(path);
+        executed = trading::executeRun(spec, &journal);
+        journal.close();
+    }
+    assert(executed.stages.size() == 6);
+    assert(executed.outputs.size() == 2);
+    assert(executed.inputBars == trading::loadBarsFromCsv(spec.csvPath).size());
+
+    const RunJournal recorded = trading::readJournal(path);
+    assert(!recorded.truncated);
+    assert(recorded.spec.csvPath == spec.csvPath);
+    assert(recorded.spec.twmaTimeConstantDays == 7.5);
+    assert(recorded.spec.vwmaWindow == 15);
+    assert(recorded.spec.periodsPerYear == 250);
+    assert(recorded.spec.startingEquity == 100.0);
+    assert(recorded.inputFingerprint == executed.inputFingerprint);
+    assert(recorded.stages.size() == executed.stages.size());
+    for (std::size_t i = 0; i < recorded.stages.size(); ++i)
+    {
+        assert(recorded.stages[i].name == executed.stages[i].name);
+        assert(recorded.stages[i].durationNs == executed.stages[i].durationNs);
+    }
+    assert(recorded.outputs[1].name == "strategy");
+    assert(recorded.outputs[1].returns.annualized_return == executed.outputs[1].returns.annualized_return);
+    assert(recorded.outputs[1].maxDrawdown == executed.outputs[1].maxDrawdown);
+
+    // --- Replay reproduces the outputs bit for bit -------------------------------
+    const auto diff = trading::replayJournal(path);
+    assert(diff.inputMatches);
+    assert(diff.outputsMatch());
+    assert(diff.stages.size() == 6 && diff.stages[0].name == "load");
+    std::cout << diff.summary();
+
+    // A journal whose outputs were produced by different code is flagged.
+    RunJournal tampered = recorded;
+    tampered.outputs[0].maxDrawdown += 1e-9;
+    const auto bad = trading::replayJournal(tampered);
+    assert(!bad.outputsMatch());
+    assert(bad.outputMismatches.size() == 1);
+    assert(bad.outputMismatches[0].rfind("buy_and_hold.max_drawdown", 0) == 0);
+    assert(trading::replayJournal(tampered, 1e-6).outputsMatch());
+
+    tampered = recorded;
+    tampered.inputFingerprint ^= 1;
+    assert(!trading::replayJournal(tampered).outputsMatch());
+
+    // --- Fingerprint sees every field --------------------------------------------
+    auto bars = trading::loadBarsFromCsv(spec.csvPath);
+    const auto fingerprint = trading::fingerprintBars(bars);
+    bars[10].volume += 1.0;
+    assert(trading::fingerprintBars(bars) != fingerprint);
+
+    // --- Records from several threads, then a torn tail ---------------------------
+    {
+        JournalWriter journal(path);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&journal, t]
+            {
+                for (int i = 0; i < 100; ++i)
+                {
+                    journal.writeStage("stage" + std::to_string(t), static_cast<std::uint64_t>(i));
+                }
+            });
+        }
+        for (auto &th : threads)
+        {
+            th.join();
+        }
+    } // destructor drains and closes
+    const RunJournal many = trading::readJournal(path);
+    assert(many.stages.size() == 400);
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    const RunJournal torn = trading::readJournal(path);
+    assert(torn.truncated);
+    assert(torn.stages.size() == 399);
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "NOPE0000";
+    bool threw = false;
+    try
+    {
+        trading::readJournal(path);
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+    std::filesystem::remove(path);
+
+    std::cout << "run_journal_test passed\n";
+    return 0;
+}
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "data/csv_loader.h"
+#include "data/snapshot.h"
+#include "metrics/moving_average.h"
+#include "metrics/rolling_metrics.h"
+
+using trading::RollingWindowMetrics;
+using trading::SnapshotKind;
+using trading::TimeWeightedMovingAverage;
+using trading::VolumeWeightedMovingAverage;
+
+// A reader only refers to its buffer, so it must not bind to a temporary.
+static_assert(std::is_constructible_v<trading::SnapshotReader, const std::vector<std::uint8_t> &>);
+static_assert(!std::is_constructible_v<trading::SnapshotReader, std::vector<std::uint8_t>>);
+static_assert(!std::is_constructible_v<trading::SnapshotReader, const std::vector<std::uint8_t>>);
+
+namespace
+{
+    bool sameValue(double a, double b)
+    {
+        return (std::isnan(a) && std::isnan(b)) || a == b;
+    }
+
+    template <typename Fn>
+    bool throws(Fn &&fn)
+    {
+        try
+        {
+            fn();
+        }
+        catch (const std::runtime_error &)
+        {
+            return true;
+        }
+        return false;
+    }
+}
+
+int main()
+{
+    const auto fixture = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+    const auto bars = trading::loadBarsFromCsv(fixture);
+    const std::size_t split = 300;
+
+    // --- Warm up live state on the first part of the history --------------
+    TimeWeightedMovingAverage twma(7.5);
+    VolumeWeightedMovingAverage vwma(20);
+    RollingWindowMetrics rolling(60);
+    for (std::size_t i = 0; i < split; ++i)
+    {
+        twma.update(bars[i]);
+        vwma.update(bars[i]);
+        rolling.update(bars[i].close);
+    }
+
+    trading::SnapshotWriter writer;
+    writer.beginRecord(SnapshotKind::TimeWeightedMovingAverage, bars[0].symbol);
+    trading::saveState(writer, twma);
+    writer.endRecord();
+    writer.beginRecord(static_cast<SnapshotKind>(99), "future-kind"); // unknown to this reader
+    writer.writeU64(123);
+    writer.endRecord();
+    writer.beginRecord(SnapshotKind::VolumeWeightedMovingAverage, bars[0].symbol);
+    trading::saveState(writer, vwma);
+    writer.endRecord();
+    writer.beginRecord(SnapshotKind::RollingWindowMetrics, bars[0].symbol);
+    trading::saveState(writer, rolling);
+    writer.endRecord();
+    const auto buffer = writer.finish();
+
+    const auto path = std::filesystem::temp_directory_path() / "trading_snapshot_test.bin";
+    trading::writeSnapshotFile(path, buffer);
+    const auto loaded = trading::readSnapshotFile(path);
+    std::filesystem::remove(path);
+    assert(loaded == buffer);
+
+    // --- Restore into fresh objects with different parameters --------------
+    TimeWeightedMovingAverage twmaRestored(1.0);
+    VolumeWeightedMovingAverage vwmaRestored(3);
+    RollingWindowMetrics rollingRestored(3);
+
+    trading::SnapshotReader reader(loaded);
+    assert(reader.version() == trading::kSnapshotVersion);
+    assert(reader.recordCount() == 4);
+
+    trading::SnapshotRecord record;
+    std::size_t restored = 0;
+    while (reader.nextRecord(record))
+    {
+        switch (record.kind)
+        {
+        case SnapshotKind::TimeWeightedMovingAverage:
+            trading::restoreState(reader, twmaRestored);
+            ++restored;
+            break;
+        case SnapshotKind::VolumeWeightedMovingAverage:
+            trading::restoreState(reader, vwmaRestored);
+            ++restored;
+            break;
+        case SnapshotKind::RollingWindowMetrics:
+            trading::restoreState(reader, rollingRestored);
+            ++restored;
+            break;
+        default:
+            assert(record.symbol == "future-kind"); // skipped
+            break;
+        }
+    }
+    assert(restored == 3);
+    assert(twmaRestored.value() == twma.value());
+
+    // --- Restored state continues bit-for-bit ------------------------------
+    for (std::size_t i = split; i < bars.size(); ++i)
+    {
+        assert(twmaRestored.update(bars[i]) == twma.update(bars[i]));
+        assert(sameValue(vwmaRestored.update(bars[i]), vwma.update(bars[i])));
+        rolling.update(bars[i].close);
+        rollingRestored.update(bars[i].close);
+        const auto a = rolling.value();
+        const auto b = rollingRestored.value();
+        assert(a.max_drawdown == b.max_drawdown);
+        assert(a.volatility == b.volatility);
+        assert(a.annualized_return == b.annualized_return);
+    }
+
+    // --- Corrupt buffers are rejected --------------------------------------
+    std::vector<std::uint8_t> badMagic = buffer;
+    badMagic[0] = 'X';
+    assert(throws([&] { trading::SnapshotReader r(badMagic); }));
+
+    std::vector<std::uint8_t> truncated(buffer.begin(), buffer.begin() + 40);
+    assert(throws([&]
+                  {
+                      trading::SnapshotReader r(truncated);
+                      trading::SnapshotRecord rec;
+                      while (r.nextRecord(rec))
+                      {
+                      } }));
+
+    // Rolling state whose counts disagree with each other or with the payload.
+    const auto rollingRecord = [](std::uint64_t window, std::uint64_t count, std::uint64_t returns,
+                                  std::uint64_t nFront, std::uint64_t nBack)
+    {
+        trading::SnapshotWriter w;
+        w.beginRecord(SnapshotKind::RollingWindowMetrics, "X");
+        w.writeU64(window);
+        w.writeU32(245);
+        w.writeU64(count);
+        w.writeU64(0);
+        for (std::uint64_t k = 0; k < std::min<std::uint64_t>(count, 64); ++k)
+        {
+            w.writeF64(100.0 + static_cast<double>(k));
+        }
+        w.writeU64(returns);
+        w.writeF64(0.0);
+        w.writeF64(0.0);
+        w.writeU64(nFront);
+        for (std::uint64_t k = 0; k < std::min<std::uint64_t>(nFront, 64); ++k)
+        {
+            w.writeF64(100.0);
+            w.writeF64(100.0);
+            w.writeF64(0.0);
+        }
+        w.writeU64(nBack);
+        for (std::uint64_t k = 0; k < std::min<std::uint64_t>(nBack, 64); ++k)
+        {
+            w.writeF64(100.0);
+        }
+        w.writeF64(100.0);
+        w.writeF64(100.0);
+        w.writeF64(0.0);
+        w.endRecord();
+        return w.finish();
+    };
+    const auto restoresRolling = [](const std::vector<std::uint8_t> &bytes)
+    {
+        trading::SnapshotReader r(bytes);
+        trading::SnapshotRecord rec;
+        r.nextRecord(rec);
+        RollingWindowMetrics target(3);
+        trading::restoreState(r, target);
+    };
+    const auto good = rollingRecord(10, 5, 4, 2, 3);
+    restoresRolling(good);
+    assert(throws([&] { restoresRolling(rollingRecord(std::uint64_t{1} << 40, 5, 4, 2, 3)); }));
+    assert(throws([&] { restoresRolling(rollingRecord(1 << 20, 1 << 20, (1 << 20) - 1, 0, 1 << 20)); }));
+    assert(throws([&] { restoresRolling(rollingRecord(10, 5, 3, 2, 3)); }));
+    assert(throws([&] { restoresRolling(rollingRecord(10, 5, 4, std::uint64_t{1} << 40, 3)); }));
+    assert(throws([&] { restoresRolling(rollingRecord(10, 5, 4, 2, 2)); }));
+
+    // VWMA state whose value count disagrees with its running count.
+    const auto vwmaRecord = [](std::uint64_t window, std::uint64_t count, std::uint64_t n)
+    {
+        trading::SnapshotWriter w;
+        w.beginRecord(SnapshotKind::VolumeWeightedMovingAverage, "X");
+        w.writeU64(window);
+        w.writeU64(count);
+        w.writeF64(0.0);
+        w.writeF64(0.0);
+        w.writeU64(n);
+        for (std::uint64_t k = 0; k < std::min<std::uint64_t>(n, 64); ++k)
+        {
+            w.writeF64(100.0);
+            w.writeF64(1.0);
+        }
+        w.endRecord();
+        return w.finish();
+    };
+    const auto restoresVwma = [](const std::vector<std::uint8_t> &bytes)
+    {
+        trading::SnapshotReader r(bytes);
+        trading::SnapshotRecord rec;
+        r.nextRecord(rec);
+        VolumeWeightedMovingAverage target(3);
+        trading::restoreState(r, target);
+        return target;
+    };
+    auto vwmaGood = restoresVwma(vwmaRecord(4, 9, 4));
+    vwmaGood.update(bars[0]);
+    restoresVwma(vwmaRecord(4, 2, 2));
+    assert(throws([&] { restoresVwma(vwmaRecord(4, 9, 0)); })); // would pop an empty deque
+    assert(throws([&] { restoresVwma(vwmaRecord(4, 2, 3)); }));
+    assert(throws([&] { restoresVwma(vwmaRecord(0, 0, 0)); })); // runtime_error, not invalid_argument
+    assert(throws([&] { restoresVwma(vwmaRecord(std::uint64_t{1} << 40, 0, 0)); }));
+
+    // --- Thousands of symbols in one buffer --------------------------------
+    const std::size_t symbols = 5000;
+    std::vector<VolumeWeightedMovingAverage> live(symbols, VolumeWeightedMovingAverage(20));
+    for (std::size_t s = 0; s < symbols; ++s)
+    {
+        for (std::size_t i = 0; i < 25; ++i)
+        {
+            live[s].update(bars[(s + i) % bars.size()]);
+        }
+    }
+
+    trading::SnapshotWriter bulk;
+    for (std::size_t s = 0; s < symbols; ++s)
+    {
+        bulk.beginRecord(SnapshotKind::VolumeWeightedMovingAverage, "SYM" + std::to_string(s));
+        trading::saveState(bulk, live[s]);
+        bulk.endRecord();
+    }
+    const auto bulkBuffer = bulk.finish();
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<VolumeWeightedMovingAverage> restoredLive(symbols, VolumeWeightedMovingAverage(1));
+    trading::SnapshotReader bulkReader(bulkBuffer);
+    for (std::size_t s = 0; bulkReader.nextRecord(record); ++s)
+    {
+        trading::restoreState(bulkReader, restoredLive[s]);
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    std::cout << "restored " << symbols << " VWMA states (" << bulkBuffer.size() << " bytes) in "
+              << elapsed.count() << " ms\n";
+
+    for (std::size_t s = 0; s < symbols; ++s)
+    {
+        assert(sameValue(restoredLive[s].update(bars[s % bars.size()]), live[s].update(bars[s % bars.size()])));
+    }
+
+    std::cout << "snapshot_test passed\n";
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "backtest/strategy.h"
+#include "data/csv_loader.h"
+#include "metrics/calculate_equity_curve.h"
+#include "metrics/drawdown.h"
+#include "metrics/moving_average.h"
+#include "metrics/return_metrics.h"
+
+using trading::Position;
+
+namespace
+{
+    bool near(double a, double b)
+    {
+        return std::fabs(a - b) <= 1e-12 * std::max(1.0, std::fabs(b));
+    }
+}
+
+int main()
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    // --- Positions -------------------------------------------------------------
+    const std::vector<double> fast = {nan, 1.0, 2.0, 3.0, 2.0};
+    const std::vector<double> slow = {1.0, nan, 2.0, 2.5, 2.5};
+    assert((trading::crossoverPositions(fast, slow) == std::vector<Position>{0, 0, 0, 1, 0}));
+    assert((trading::crossoverPositions(fast, slow, 1, -1) == std::vector<Position>{0, 0, 0, 1, -1}));
+    assert((trading::crossoverPositions(fast, slow, -1, 1) == std::vector<Position>{0, 0, 0, -1, 1}));
+
+    const std::vector<double> signal = {nan, 0.5, -0.5, 0.1, 0.2};
+    assert((trading::thresholdPositions(signal, 0.2, -0.2) == std::vector<Position>{0, 1, -1, 0, 0}));
+    assert((trading::thresholdPositions(signal, 0.0, 0.0, 1, 0) == std::vector<Position>{0, 1, 0, 1, 1}));
+
+    bool threw = false;
+    try
+    {
+        trading::crossoverPositions({1.0}, {1.0, 2.0});
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    // --- Equity ------------------------------------------------------------------
+    const std::vector<double> closes = {100.0, 110.0, 99.0, 99.0, 120.0};
+    const auto longShort = trading::strategyEquity(closes, {1, -1, 0, 1, 0}, 10.0);
+    assert(longShort.size() == closes.size());
+    assert(longShort[0] == 10.0);
+    assert(near(longShort[1], 11.0));          // long +10%
+    assert(near(longShort[2], 11.0 * 1.1));    // short through -10%
+    assert(near(longShort[3], longShort[2]));  // flat
+    assert(near(longShort[4], longShort[3] * 120.0 / 99.0));
+
+    threw = false;
+    try
+    {
+        trading::strategyEquity({100.0, 0.0}, {1, 1});
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    // --- Always long reproduces buy-and-hold ------------------------------------
+    const auto fixture = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+    const auto bars = trading::loadBarsFromCsv(fixture);
+    const auto hold = trading::calculate_equity_curve_from_bars(bars, 100.0);
+    const auto allLong = trading::strategyEquityFromBars(bars, std::vector<Position>(bars.size(), 1), 100.0);
+    for (std::size_t i = 0; i < bars.size(); ++i)
+    {
+        assert(std::fabs(allLong[i] - hold[i]) <= 1e-9 * hold[i]);
+    }
+
+    // --- TWMA/VWMA crossover feeds the metric kernels ---------------------------
+    const auto twma = trading::TimeWeightedMovingAverage::compute(bars, 5);
+    const auto vwma = trading::VolumeWeightedMovingAverage::compute(bars, 20);
+    const auto positions = trading::crossoverPositions(twma, vwma, 1, -1);
+    for (std::size_t i = 0; i < 19; ++i)
+    {
+        assert(positions[i] == 0); // VWMA warm-up is NaN
+    }
+    const auto equity = trading::strategyEquityFromBars(bars, positions, 100.0);
+    const trading::ReturnCalculator calc;
+    const auto metrics = calc.from_equity(equity);
+    const double dd = trading::max_drawdown(equity);
+    assert(std::isfinite(metrics.annualized_return));
+    assert(dd >= 0.0 && dd < 1.0);
+
+    std::cout << "strategy_test passed\n";
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/bar.h"
+#include "core/bar_columns.h"
+#include "core/symbol_table.h"
+#include "data/bar_codec.h"
+#include "data/csv_loader.h"
+
+using trading::Bar;
+using trading::SymbolId;
+using trading::SymbolTable;
+
+int main()
+{
+    // --- Interning ------------------------------------------------------------
+    SymbolTable table;
+    const SymbolId a = table.intern("AAA");
+    const SymbolId b = table.intern("BBB");
+    assert(a == 0 && b == 1);
+    assert(table.intern(std::string("AAA")) == a);
+    assert(table.size() == 2);
+    assert(table.name(b) == "BBB");
+    assert(table.find("BBB") == b);
+    assert(!table.find("CCC").has_value());
+
+    bool threw = false;
+    try
+    {
+        table.name(7);
+    }
+    catch (const std::out_of_range &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    // Concurrent interning of overlapping names yields one id per name.
+    SymbolTable shared;
+    std::vector<std::vector<SymbolId>> seen(4);
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < seen.size(); ++t)
+    {
+        workers.emplace_back([&, t]
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                seen[t].push_back(shared.intern("S" + std::to_string(i % 50)));
+            }
+        });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    assert(shared.size() == 50);
+    for (const auto &ids : seen)
+    {
+        assert(ids == seen[0]);
+        for (int i = 0; i < 1000; ++i)
+        {
+            assert(shared.name(ids[i]) == "S" + std::to_string(i % 50));
+        }
+    }
+
+    // --- Column loader emits ids ---------------------------------------------
+    const auto fixture = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+    const auto bars = trading::loadBarsFromCsv(fixture);
+    const auto columns = trading::loadBarColumnsFromCsv(fixture);
+    assert(columns.size() == bars.size());
+    const SymbolId ticker = trading::symbolTable().intern(bars.front().symbol);
+    for (std::size_t i = 0; i < columns.size(); ++i)
+    {
+        assert(columns.symbolIds[i] == ticker);
+    }
+    assert(trading::periodTable().name(columns.periodIds[0]) == "D");
+
+    const auto roundTrip = trading::toBars(columns);
+    const auto expected = trading::toColumns(bars);
+    assert(roundTrip.size() == bars.size());
+    assert(expected.symbolIds == columns.symbolIds);
+    assert(expected.timestamps == columns.timestamps);
+    assert(expected.close == columns.close);
+    for (std::size_t i = 0; i < bars.size(); ++i)
+    {
+        assert(roundTrip[i].symbol == bars[i].symbol);
+        assert(roundTrip[i].period == bars[i].period);
+        assert(roundTrip[i].date == bars[i].date);
+        assert(roundTrip[i].close == bars[i].close);
+    }
+
+    // --- Group by symbol -------------------------------------------------------
+    const std::vector<Bar> mixed = {
+        {"ZZZ", "D", "20240101", "000000", 1.0, 1.0, 1.0, 1.0, 1.0, 0},
+        {"YYY", "D", "20240101", "000000", 2.0, 2.0, 2.0, 2.0, 1.0, 0},
+        {"ZZZ", "D", "20240102", "000000", 3.0, 3.0, 3.0, 3.0, 1.0, 0},
+        {"ZZZ", "D", "20240103", "000000", 4.0, 4.0, 4.0, 4.0, 1.0, 0},
+    };
+    const auto mixedColumns = trading::toColumns(mixed);
+    const auto groups = trading::groupBySymbol(mixedColumns);
+    assert(groups.size() == 2);
+    assert(trading::symbolTable().name(groups[0].symbol) == "ZZZ");
+    assert((groups[0].rows == std::vector<std::size_t>{0, 2, 3}));
+    assert((groups[1].rows == std::vector<std::size_t>{1}));
+    const auto zzz = trading::selectRows(mixedColumns, groups[0].rows);
+    assert((zzz.close == std::vector<double>{1.0, 3.0, 4.0}));
+
+    // --- Decoded columns carry process-wide ids --------------------------------
+    const auto series = trading::CompressedBarSeries::encode(mixed, 2);
+    const auto decoded = series.decodeColumns();
+    assert(decoded.symbolIds == mixedColumns.symbolIds);
+    assert(decoded.periodIds == mixedColumns.periodIds);
+
+    std::cout << "symbol_table_test passed\n";
+    return 0;
+}
@@ -0,0 +1,253 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "backtest/symbol_metrics.h"
+#include "core/bar.h"
+#include "core/task_scheduler.h"
+#include "core/topology.h"
+#include "data/csv_loader.h"
+#include "metrics/calculate_equity_curve.h"
+#include "metrics/drawdown.h"
+
+using trading::Bar;
+using trading::CpuTopology;
+using trading::TaskScheduler;
+using trading::TaskSchedulerConfig;
+
+int main()
+{
+    // --- CPU lists and sysfs parsing ---------------------------------------------
+    assert((trading::parseCpuList("0-3,8,10-11\n") == std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    assert(trading::parseCpuList("").empty());
+    bool threw = false;
+    try
+    {
+        trading::parseCpuList("3-1");
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    const auto root = std::filesystem::temp_directory_path() / "trading_topology_test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "node1");
+    std::filesystem::create_directories(root / "node0");
+    std::filesystem::create_directories(root / "possible");
+    std::ofstream(root / "node0" / "cpulist") << "0-1\n";
+    std::ofstream(root / "node1" / "cpulist") << "2-3\n";
+    const CpuTopology fake = CpuTopology::fromSysfs(root);
+    std::filesystem::remove_all(root);
+    assert(fake.nodes.size() == 2);
+    assert(fake.nodes[0].id == 0 && fake.nodes[1].id == 1);
+    assert((fake.nodes[1].cpus == std::vector<int>{2, 3}));
+    assert(fake.cpuCount() == 4);
+    assert(CpuTopology::fromSysfs(root).nodes.empty());
+
+    const CpuTopology detected = CpuTopology::detect();
+    assert(!detected.nodes.empty() && detected.cpuCount() > 0);
+
+    // --- Scheduler on a two-node topology ------------------------------------------
+    // The fake CPUs may not exist here; pinning then fails and is only counted.
+    TaskScheduler scheduler(fake, TaskSchedulerConfig{4, true});
+    assert(scheduler.workerCount() == 4);
+    assert(scheduler.workerNode(0) == 0 && scheduler.workerNode(1) == 1);
+    assert(scheduler.workerNode(2) == 0 && scheduler.workerNode(3) == 1);
+    // Keys alternate nodes and then spread over each node's workers.
+    assert(scheduler.homeWorker(0) == 0 && scheduler.homeWorker(1) == 1);
+    assert(scheduler.homeWorker(2) == 2 && scheduler.homeWorker(3) == 3);
+    assert(scheduler.homeWorker(4) == 0);
+
+    // Worker 0 blocks on its first task until every other task has finished,
+    // so its remaining queued tasks have to be stolen.
+    constexpr std::size_t kTasks = 16;
+    std::vector<std::atomic<int>> runs(kTasks);
+    std::atomic<std::size_t> done{0};
+    std::atomic<bool> blocked{false};
+    const auto stats = scheduler.run(kTasks, [&](std::size_t i, std::size_t worker)
+    {
+        if (worker == 0 && !blocked.exchange(true))
+        {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (done.load() < kTasks - 1 && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::yield();
+            }
+        }
+        ++runs[i];
+        ++done;
+    });
+
+    for (const auto &r : runs)
+    {
+        assert(r.load() == 1);
+    }
+    assert(stats.nodes.size() == 2);
+    std::size_t tasks = 0;
+    std::size_t steals = 0;
+    for (const auto &node : stats.nodes)
+    {
+        assert(node.workers == 2);
+        tasks += node.tasks;
+        steals += node.localSteals + node.remoteSteals;
+    }
+    assert(tasks == kTasks);
+    assert(steals >= 3);
+
+    // Exceptions propagate to the caller.
+    threw = false;
+    try
+    {
+        scheduler.run(8, [](std::size_t i, std::size_t)
+        {
+            if (i == 5)
+            {
+                throw std::runtime_error("task failed");
+            }
+        });
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    // Tasks start on their home worker; a home list of the wrong size is rejected.
+    TaskScheduler single(fake, TaskSchedulerConfig{1, false});
+    std::vector<std::size_t> ranOn(3, 99);
+    single.run(3, std::vector<std::size_t>(3, 0), [&](std::size_t i, std::size_t worker)
+    {
+        ranOn[i] = worker;
+    });
+    assert((ranOn == std::vector<std::size_t>{0, 0, 0}));
+
+    // Workers are long-lived: every run uses the same threads. With stealing
+    // disabled, tasks stay on their home worker even while others are idle.
+    std::vector<std::thread::id> firstIds(scheduler.workerCount());
+    std::vector<std::thread::id> secondIds(scheduler.workerCount());
+    const std::vector<std::size_t> eachWorker{0, 1, 2, 3};
+    scheduler.run(4, eachWorker, [&](std::size_t i, std::size_t worker)
+    {
+        assert(i == worker);
+        firstIds[worker] = std::this_thread::get_id();
+    }, trading::Stealing::Disabled);
+    scheduler.run(4, eachWorker, [&](std::size_t, std::size_t worker)
+    {
+        secondIds[worker] = std::this_thread::get_id();
+    }, trading::Stealing::Disabled);
+    assert(firstIds == secondIds);
+
+    std::vector<std::size_t> pinnedOn(kTasks, 99);
+    const auto homeStats = scheduler.run(kTasks, std::vector<std::size_t>(kTasks, 2), [&](std::size_t i, std::size_t worker)
+    {
+        pinnedOn[i] = worker;
+    }, trading::Stealing::Disabled);
+    assert(pinnedOn == std::vector<std::size_t>(kTasks, 2));
+    assert(homeStats.nodes[0].localSteals + homeStats.nodes[0].remoteSteals == 0);
+    threw = false;
+    try
+    {
+        single.run(3, std::vector<std::size_t>(2, 0), [](std::size_t, std::size_t) {});
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    // --- Per-symbol metric pipeline matches a serial run ----------------------------
+    const auto fixture = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+    const auto sample = trading::loadBarsFromCsv(fixture);
+    std::vector<Bar> mixed;
+    for (const char *symbol : {"AAA", "BBB", "CCC"})
+    {
+        for (const Bar &bar : sample)
+        {
+            mixed.push_back(bar);
+            mixed.back().symbol = symbol;
+        }
+    }
+
+    TaskScheduler local(CpuTopology::detect(), TaskSchedulerConfig{2, true});
+    const trading::ReturnCalculator calc;
+    const auto result = trading::runSymbolMetrics(mixed, local, calc, 100.0);
+    assert(result.symbols.size() == 3);
+    assert(result.symbols[0].symbol == "AAA" && result.symbols[2].symbol == "CCC");
+
+    const auto equity = trading::calculate_equity_curve_from_bars(sample, 100.0);
+    const auto expected = calc.from_equity(equity);
+    for (const auto &m : result.symbols)
+    {
+        assert(m.ok());
+        assert(m.bars == sample.size());
+        assert(m.returns.cumulative_return == expected.cumulative_return);
+        assert(m.returns.annualized_return == expected.annualized_return);
+        assert(m.maxDrawdown == trading::max_drawdown(equity));
+    }
+
+    // A partition keeps each symbol on the same home worker across runs.
+    const trading::SymbolPartition partition(trading::toColumns(mixed), local);
+    assert(partition.symbols().size() == 3);
+    for (const auto &placed : partition.symbols())
+    {
+        assert(placed.worker == local.homeWorker(placed.symbol));
+        assert(placed.columns.size() == sample.size());
+    }
+    const auto first = trading::runSymbolMetrics(partition, local, calc, 100.0);
+    const auto second = trading::runSymbolMetrics(partition, local, calc, 100.0);
+    for (std::size_t g = 0; g < 3; ++g)
+    {
+        assert(first.symbols[g].symbol == result.symbols[g].symbol);
+        assert(first.symbols[g].returns.annualized_return == second.symbols[g].returns.annualized_return);
+        assert(first.symbols[g].maxDrawdown == result.symbols[g].maxDrawdown);
+    }
+
+    // A one-bar symbol and a bad close are skipped; the rest of the universe runs.
+    std::vector<Bar> ragged = mixed;
+    ragged.push_back(sample.front());
+    ragged.back().symbol = "ONE";
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+        ragged.push_back(sample[i]);
+        ragged.back().symbol = "BAD";
+    }
+    ragged.back().close = 0.0;
+    const auto partial = trading::runSymbolMetrics(ragged, local, calc, 100.0);
+    assert(partial.symbols.size() == 5);
+    for (std::size_t g = 0; g < 3; ++g)
+    {
+        assert(partial.symbols[g].ok());
+        assert(partial.symbols[g].returns.annualized_return == result.symbols[g].returns.annualized_return);
+        assert(partial.symbols[g].maxDrawdown == result.symbols[g].maxDrawdown);
+    }
+    assert(partial.symbols[3].symbol == "ONE" && !partial.symbols[3].ok() && partial.symbols[3].bars == 1);
+    assert(partial.symbols[4].symbol == "BAD" && !partial.symbols[4].ok() && partial.symbols[4].bars == 5);
+    std::size_t ranTasks = 0;
+    for (const auto &node : partial.stats.nodes)
+    {
+        ranTasks += node.tasks;
+    }
+    assert(ranTasks == 5);
+
+    threw = false;
+    try
+    {
+        trading::runSymbolMetrics(partition, local, calc, 0.0);
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "task_scheduler_test passed\n";
+    return 0;
+}
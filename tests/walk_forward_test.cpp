@@ -0,0 +1,121 @@
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include "backtest/walk_forward.h"
+#include "data/csv_loader.h"
+#include "metrics/drawdown.h"
+#include "metrics/moving_average.h"
+
+using trading::FoldScheme;
+using trading::WalkForwardConfig;
+
+namespace
+{
+    // Brute-force train score of one parameter set: recompute both indicators
+    // for this fold alone instead of sharing them across folds.
+    double referenceScore(const std::vector<trading::Bar> &bars,
+                          const trading::ParameterSet &params,
+                          std::size_t begin,
+                          std::size_t end,
+                          const WalkForwardConfig &config)
+    {
+        trading::TimeWeightedMovingAverage twma(params.twmaTimeConstantDays);
+        const auto vwma = trading::VolumeWeightedMovingAverage::compute(bars, params.vwmaWindow);
+
+        std::vector<double> equity{1.0};
+        for (std::size_t i = 0; i + 1 < end; ++i)
+        {
+            const double fast = twma.update(bars[i]);
+            if (i >= begin)
+            {
+                const double r = bars[i + 1].close / bars[i].close - 1.0;
+                equity.push_back(equity.back() * (1.0 + ((fast > vwma[i]) ? r : 0.0)));
+            }
+        }
+        return trading::scoreEquity(equity, config.metric, trading::ReturnCalculator(config.periodsPerYear),
+                                    trading::InputCheck::Checked, config.minDrawdown);
+    }
+}
+
+int main()
+{
+    // --- Fold construction --------------------------------------------------
+    const auto rolling = trading::makeWalkForwardFolds(10, 4, 3, FoldScheme::Rolling);
+    assert(rolling.size() == 2);
+    assert(rolling[0].trainBegin == 0 && rolling[0].trainEnd == 4 && rolling[0].testEnd == 7);
+    assert(rolling[1].trainBegin == 3 && rolling[1].trainEnd == 7 && rolling[1].testEnd == 10);
+
+    const auto anchored = trading::makeWalkForwardFolds(11, 4, 3, FoldScheme::Anchored);
+    assert(anchored.size() == 3);
+    assert(anchored[2].trainBegin == 0 && anchored[2].trainEnd == 10);
+    assert(anchored[2].testBegin == 10 && anchored[2].testEnd == 11); // short last fold
+
+    // --- Return over drawdown with a drawdown-free candidate -----------------
+    // A never draws down but barely moves; B returns far more with a 2% dip.
+    const trading::ReturnCalculator calc(245);
+    std::vector<double> flat{1.0};
+    std::vector<double> better{1.0};
+    for (int i = 1; i <= 60; ++i)
+    {
+        flat.push_back(flat.back() * 1.00001);
+        better.push_back(better.back() * ((i == 30) ? 0.98 : 1.0005));
+    }
+    const auto rod = trading::SelectionMetric::ReturnOverDrawdown;
+    assert(trading::max_drawdown(flat) == 0.0);
+    assert(trading::scoreEquity(better, rod, calc) > trading::scoreEquity(flat, rod, calc));
+    // Among drawdown-free candidates the larger return still wins.
+    std::vector<double> flatter(flat.size(), 1.0);
+    assert(trading::scoreEquity(flat, rod, calc) > trading::scoreEquity(flatter, rod, calc));
+
+    // --- Walk-forward on the fixture ----------------------------------------
+    const auto fixture = std::filesystem::path(__FILE__).parent_path() / "data" / "sample.csv";
+    const auto bars = trading::loadBarsFromCsv(fixture);
+
+    for (FoldScheme scheme : {FoldScheme::Rolling, FoldScheme::Anchored})
+    {
+        WalkForwardConfig config;
+        config.twmaTimeConstants = {3.0, 5.0, 10.0};
+        config.vwmaWindows = {5, 10, 20};
+        config.trainSize = 120;
+        config.testSize = 40;
+        config.scheme = scheme;
+        config.threads = 4;
+
+        const auto result = trading::runWalkForward(bars, config);
+        const auto folds = trading::makeWalkForwardFolds(bars.size(), 120, 40, scheme);
+        assert(result.folds.size() == folds.size());
+
+        std::size_t testBars = 0;
+        for (std::size_t f = 0; f < folds.size(); ++f)
+        {
+            const auto &fold = result.folds[f];
+            testBars += fold.fold.testEnd - fold.fold.testBegin;
+
+            // Selected parameters are the brute-force argmax of the train score.
+            double bestScore = -INFINITY;
+            for (const auto &params : trading::makeParameterGrid(config))
+            {
+                bestScore = std::max(bestScore, referenceScore(bars, params, fold.fold.trainBegin, fold.fold.trainEnd, config));
+            }
+            assert(std::fabs(fold.trainScore - bestScore) <= 1e-12 * std::max(1.0, std::fabs(bestScore)));
+            assert(fold.testMaxDrawdown >= 0.0 && fold.testMaxDrawdown < 1.0);
+        }
+        assert(result.outOfSampleEquity.size() == testBars + 1);
+
+        // Results do not depend on the thread count.
+        config.threads = 1;
+        const auto serial = trading::runWalkForward(bars, config);
+        assert(serial.outOfSampleEquity == result.outOfSampleEquity);
+        for (std::size_t f = 0; f < folds.size(); ++f)
+        {
+            assert(serial.folds[f].best.vwmaWindow == result.folds[f].best.vwmaWindow);
+            assert(serial.folds[f].best.twmaTimeConstantDays == result.folds[f].best.twmaTimeConstantDays);
+        }
+    }
+
+    std::cout << "walk_forward_test passed\n";
+    return 0;
+}